@@ -20,7 +20,11 @@ double getTimeMs();
 typedef void (Handler)();
 static Handler* _handler;
 
+// set during a replay, which owns time and runs the interrupts itself //
+bool FastWait = false;
+
 void Wait(long ulTime) {
+    if(FastWait) return;
     unsigned long start   = GetMsClock();
     unsigned long nextISR = 0;
     while((GetMsClock() - start) < ulTime) {
@@ -35,8 +39,11 @@ unsigned long GetMsClock() {
     return (unsigned long) (getTimeMs() - StartTime);
 }
 
+// cleared by a host driver to end the current run mode //
+unsigned char StubEnabled = true;
+
 unsigned char IsEnabled(void) {
-    return true;
+    return StubEnabled;
 }
 
 void PrintToScreen(const char* msg, ...) {
@@ -261,6 +268,18 @@ unsigned char GetJoystickDigital(unsigned char ucJoystick, unsigned char ucChann
     return 0;
 }
 
+int GetJoystickAccelerometer(unsigned char ucJoystick, unsigned char ucAxis) {
+    return 0;
+}
+
+void SetJoystickAnalogDeadband(unsigned char ucPort, unsigned char ucChannel, unsigned char ucPosValue, unsigned char ucNegValue) {
+    
+}
+
+void SetJoystickAccelDeadband(unsigned char ucPort, unsigned char ucAxis, unsigned char ucPosValue, unsigned char ucNegValue) {
+    
+}
+
 void DefineIntegratedMotorEncoderPID(unsigned char ucMotor, float fKc, float fTi  , float fTd, long lTolerance) {
     
 }
@@ -7,21 +7,33 @@
 //
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <sys/time.h>
+#include <time.h>
 #include "API.h"
 #include "VexOS.h"
+#include "Clock.h"
 
 void VexOS_Initialize();
 void VexOS_OperatorControl();
 void VexOS_Autonomous();
 
 double StartTime;
+extern bool FastWait;
 double getTimeMs() {
     struct timeval t;
     gettimeofday(&t, NULL);
     return (t.tv_sec + (t.tv_usec / 1000000.0)) * 1000.0;
 }
 
+// the easyC clock only counts milliseconds, too coarse to profile with //
+static unsigned long hostMicros() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1000000UL + t.tv_nsec / 1000;
+}
+
 void autoPeriodic(EventType type, void* state) {
     Wait(100);
     PrintToScreen("  time: %d\n", GetMsClock());
@@ -32,12 +44,66 @@ void operatorPeriodic(EventType type, void* state) {
     PrintToScreen("  time: %d\n", GetMsClock());
 }
 
+#ifdef INPUTLOG
+// the "#I" lines of a captured console, other output is skipped //
+typedef struct {
+    FILE* file;
+    char  line[256];
+    char* next;
+} LogFile;
+
+static int readLogByte(void* state) {
+    LogFile* log = state;
+    unsigned int value;
+    while(log->next == NULL || sscanf(log->next, "%2x", &value) != 1) {
+        if(fgets(log->line, sizeof(log->line), log->file) == NULL) return -1;
+        log->next = (strncmp(log->line, "#I ", 3) == 0)? log->line + 3: NULL;
+    }
+    log->next += 2;
+    return value;
+}
+
+static void replayFailed(EventType type, void* state) {
+    printf("replay stopped\n");
+    exit(1);
+}
+
+// runs the recorded modes in order, as fast as the host allows //
+static int replay(const char* path) {
+    LogFile log = { fopen(path, "r"), "", NULL };
+    if(log.file == NULL) {
+        printf("can't open %s\n", path);
+        return 1;
+    }
+    FastWait = true;
+    InputLog_replay(&readLogByte, &log);
+    VexOS_addEventHandler(EventType_SystemError, &replayFailed, NULL);
+    RunMode mode;
+    while(InputLog_nextRun(&mode)) {
+        switch(mode) {
+            case RunMode_Initialize: VexOS_Initialize();      break;
+            case RunMode_Autonomous: VexOS_Autonomous();      break;
+            case RunMode_Operator:   VexOS_OperatorControl(); break;
+            default:
+                printf("bad run mode %d\n", mode);
+                return 1;
+        }
+    }
+    fclose(log.file);
+    return 0;
+}
+#endif
+
 int main(int argc, const char* argv[]) {
     GlobalData(GLOBALDATA_AUTO_PROGRAM) = 2;
     GlobalData(GLOBALDATA_DASH_NUMBER)  = 1;
     
     printf("Hello, World!\n");
     StartTime = getTimeMs();
+    Clock_setSource(&hostMicros, 1);
+#ifdef INPUTLOG
+    if(argc == 3 && strcmp(argv[1], "--replay") == 0) return replay(argv[2]);
+#endif
     VexOS_Initialize();
     VexOS_OperatorControl();
     //VexOS_Autonomous();
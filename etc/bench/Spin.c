@@ -0,0 +1,58 @@
+//
+//  Spin.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+//  Bench workload command: runs for a fixed number of loops, with an
+//  optional Subsystem requirement (-1 for none).
+//
+
+#include "CommandClass.h"
+#include "Subsystem.h"
+
+extern Subsystem BenchSystems[];
+
+/********************************************************************
+ * Class Definition                                                 *
+ ********************************************************************/
+
+DefineReentrantCommandClass(Spin, { unsigned long loops; unsigned long left; });
+
+static void constructor(Command* self, va_list argp) {
+    self->fields->loops = va_arg(argp, unsigned long);
+    int system = va_arg(argp, int);
+    if(system >= 0) require(self, &BenchSystems[system]);
+    setArgs(self, "%d", (int) self->fields->loops);
+}
+
+static void initialize(Command* self) {
+    self->fields->left = self->fields->loops;
+}
+
+static void execute(Command* self) {
+    self->fields->left--;
+}
+
+static bool isFinished(Command* self) {
+    return (self->fields->left == 0);
+}
+
+static void end(Command* self) { }
+
+static void interrupted(Command* self) { }
@@ -0,0 +1,236 @@
+//
+//  bench.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+//  Host tool: drives the Scheduler, CommandGroups and Button schedulers
+//  with a synthetic workload and reports throughput. Builds against the
+//  etc/XCode easyC stubs, so it runs on Linux.
+//
+//      make -C etc/bench
+//      etc/bench/bench -n 64 -m 8 -k 16 -d 4 -p 25 -l 200000
+//      make -C etc/bench run           (the standard matrix)
+//
+//      -n  free-running Commands, restarted as they finish
+//      -m  Subsystems, each with a default Command
+//      -k  InternalButtons, bound whileHeld and whenPressed in turn
+//      -d  depth of a nested CommandGroup, restarted as it finishes
+//      -p  percent chance per loop of preempting a Subsystem's owner
+//      -l  loops to measure, after a warm-up
+//
+//  Each run prints one line: loops per second, mallocs per loop and
+//  scheduler nodes visited per loop. The library only counts visits
+//  when built with BENCH; mallocs are counted by wrapping the linker
+//  symbols, see the Makefile.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "API.h"
+#include "VexOS.h"
+#include "Subsystem.h"
+#include "Scheduler.h"
+
+#define MAX_SYSTEMS     16
+#define MAX_COMMANDS    512
+#define MAX_BUTTONS     64
+#define WARMUP_LOOPS    1000
+
+#define System(n)       { .name = "Sys" #n, .selfPtr = &systemSelf }
+
+DeclareCommandClass(Spin);
+
+void VexOS_Initialize();
+void VexOS_OperatorControl();
+
+// controls in etc/XCode/easyC.c //
+extern bool          FastWait;
+extern unsigned char StubEnabled;
+
+static struct {
+    int           commands;
+    int           systems;
+    int           buttons;
+    int           depth;
+    int           preempt;
+    unsigned long loops;
+} config = { 16, 4, 8, 3, 10, 100000 };
+
+static Subsystem*     systemSelf;
+Subsystem             BenchSystems[MAX_SYSTEMS] = {
+    System(0), System(1), System(2),  System(3),  System(4),  System(5),  System(6),  System(7),
+    System(8), System(9), System(10), System(11), System(12), System(13), System(14), System(15)
+};
+static Subsystem*     systemList[MAX_SYSTEMS + 1];
+
+static Command*       commands[MAX_COMMANDS];
+static Command*       grabs[MAX_SYSTEMS];
+static Button*        buttons[MAX_BUTTONS];
+static Command*       group;
+
+// measured between the end of the warm-up and the last loop //
+static unsigned long  loops;
+static unsigned long  allocs;
+static unsigned long  startAllocs, startVisits;
+static double         startTime, endTime;
+
+double StartTime;
+
+double getTimeMs() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1000.0 + t.tv_nsec / 1000000.0;
+}
+
+// linked with -Wl,--wrap so only the library's own calls are seen //
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    allocs++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    allocs++;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    allocs++;
+    return __real_realloc(ptr, size);
+}
+
+static bool isRunning(Command* cmd) {
+    return (Command_getStatus(cmd) & CommandStatus_Running) != 0;
+}
+
+// each level runs a step, a child alongside it, then the next level //
+static Command* buildGroup(int depth) {
+    Command* grp = Command_new(&CommandGroup, "Level");
+    CommandGroup_addSequential(grp, Command_new(&Spin, 2UL, -1));
+    CommandGroup_addParallel(grp, Command_new(&Spin, 3UL, -1));
+    if(depth > 1) CommandGroup_addSequential(grp, buildGroup(depth - 1));
+    CommandGroup_addSequential(grp, Command_new(&Spin, 1UL, -1));
+    return grp;
+}
+
+static void drive(EventType type, void* state) {
+    int i;
+    if(++loops == WARMUP_LOOPS) {
+        startTime   = getTimeMs();
+        startAllocs = allocs;
+        startVisits = Scheduler_visits;
+    }
+    if(loops == WARMUP_LOOPS + config.loops) {
+        endTime     = getTimeMs();
+        StubEnabled = false;
+        return;
+    }
+    for(i = 0; i < config.commands; i++) {
+        if(!isRunning(commands[i])) Command_start(commands[i]);
+    }
+    if(config.systems > 0 && rand() % 100 < config.preempt) {
+        Command_start(grabs[rand() % config.systems]);
+    }
+    for(i = 0; i < config.buttons; i++) {
+        if(rand() % 8 == 0) InternalButton_set(buttons[i], rand() % 2);
+    }
+    if(group && !isRunning(group)) Command_start(group);
+}
+
+/********************************************************************
+ * Robot                                                            *
+ ********************************************************************/
+
+static void constructor() { }
+
+static void initialize() {
+    int i;
+    VexOS_setLoopFrequency(0);
+    for(i = 0; i < config.systems; i++) {
+        Subsystem_setDefaultCommand(&BenchSystems[i], Command_new(&Spin, ~0UL, i));
+        grabs[i] = Command_new(&Spin, 5UL, i);
+    }
+    for(i = 0; i < config.commands; i++) {
+        commands[i] = Command_new(&Spin, 1UL + i % 16, -1);
+    }
+    for(i = 0; i < config.buttons; i++) {
+        buttons[i] = Button_new(&InternalButton, false, false);
+        if(i % 2) Button_whenPressed(buttons[i], Command_new(&Spin, 4UL, -1));
+        else Button_whileHeld(buttons[i], Command_new(&Spin, 8UL, -1));
+    }
+    if(config.depth > 0) group = buildGroup(config.depth);
+    VexOS_addEventHandler(EventType_OperatorPeriodic, &drive, NULL);
+}
+
+const struct Robot Robot = {
+    .subsystems  = systemList,
+    .constructor = &constructor,
+    .initialize  = &initialize
+};
+
+/********************************************************************
+ * Driver                                                           *
+ ********************************************************************/
+
+static int usage() {
+    fprintf(stderr, "usage: bench [-n commands] [-m subsystems] [-k buttons] [-d depth] "
+                    "[-p preempt%%] [-l loops]\n");
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    int opt;
+    while((opt = getopt(argc, argv, "n:m:k:d:p:l:")) != -1) {
+        switch(opt) {
+            case 'n': config.commands = atoi(optarg);   break;
+            case 'm': config.systems  = atoi(optarg);   break;
+            case 'k': config.buttons  = atoi(optarg);   break;
+            case 'd': config.depth    = atoi(optarg);   break;
+            case 'p': config.preempt  = atoi(optarg);   break;
+            case 'l': config.loops    = atol(optarg);   break;
+            default:  return usage();
+        }
+    }
+    if(config.commands < 0 || config.commands > MAX_COMMANDS ||
+       config.systems  < 0 || config.systems  > MAX_SYSTEMS  ||
+       config.buttons  < 0 || config.buttons  > MAX_BUTTONS  ||
+       config.depth    < 0 || config.loops == 0) return usage();
+
+    int i;
+    for(i = 0; i < config.systems; i++) systemList[i] = &BenchSystems[i];
+    srand(1);
+    FastWait  = true;
+    StartTime = getTimeMs();
+    VexOS_Initialize();
+    VexOS_OperatorControl();
+
+    double seconds = (endTime - startTime) / 1000.0;
+    printf("BENCH n=%d m=%d k=%d d=%d p=%d loops=%lu  loops/s=%.0f  mallocs/loop=%.3f  "
+           "visits/loop=%.1f\n", config.commands, config.systems, config.buttons, config.depth,
+           config.preempt, config.loops, config.loops / seconds,
+           (double) (allocs - startAllocs) / config.loops,
+           (double) (Scheduler_visits - startVisits) / config.loops);
+    return 0;
+}
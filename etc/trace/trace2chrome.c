@@ -0,0 +1,180 @@
+//
+//  trace2chrome.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+//  Host tool: converts the text written by Trace_dump() into Chrome
+//  trace-event JSON, for chrome://tracing or ui.perfetto.dev.
+//
+//      cc -std=c99 -o trace2chrome trace2chrome.c
+//      ./trace2chrome < console.log > trace.json
+//
+//  Each Command gets its own row, spanning initialize to end or
+//  interrupt; starts and preemptions are instants on that row. Buttons
+//  get a row of press/release instants, and row 0 shows the loops.
+//
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// keep in step with TraceEvent in headers/Trace.h //
+enum {
+    TraceEvent_Loop,
+    TraceEvent_CommandStart,
+    TraceEvent_CommandInitialize,
+    TraceEvent_CommandEnd,
+    TraceEvent_CommandInterrupted,
+    TraceEvent_CommandPreempted,
+    TraceEvent_ButtonPressed,
+    TraceEvent_ButtonReleased
+};
+
+#define MAX_IDS         65536
+#define BUTTON_ROW      100000
+
+static unsigned char openCount[MAX_IDS];
+static bool          first = true;
+
+/********************************************************************
+ * Private API                                                      *
+ ********************************************************************/
+
+static void printString(const char* str) {
+    putchar('"');
+    for(; *str; str++) {
+        if(*str == '"' || *str == '\\') putchar('\\');
+        if((unsigned char) *str >= ' ') putchar(*str);
+    }
+    putchar('"');
+}
+
+static void beginEvent(const char* ph, long row, double ts) {
+    printf("%s\n  {\"ph\":\"%s\",\"pid\":1,\"tid\":%ld,\"ts\":%.3f", (first)? "": ",", ph, row, ts);
+    first = false;
+}
+
+static void printInstant(const char* name, long row, double ts) {
+    beginEvent("i", row, ts);
+    printf(",\"s\":\"t\",\"name\":\"%s\"}", name);
+}
+
+static void printRowName(long row, const char* name) {
+    beginEvent("M", row, 0);
+    printf(",\"name\":\"thread_name\",\"args\":{\"name\":");
+    printString(name);
+    printf("}}");
+    beginEvent("M", row, 0);
+    printf(",\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":%ld}}", row);
+}
+
+/********************************************************************
+ * Public API                                                       *
+ ********************************************************************/
+
+int main(void) {
+    char line[256];
+    bool inTrace = false, done = false, inLoop = false, haveTicks = false;
+    unsigned int ticksPerMicro = 1, count = 0;
+    unsigned long lastTicks = 0;
+    double ts = 0;
+
+    printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    while(!done && fgets(line, sizeof(line), stdin)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if(!inTrace) {
+            // only the first trace in the input is converted //
+            if(sscanf(line, "#TRACE 1 %u %u", &ticksPerMicro, &count) == 2) {
+                inTrace = true;
+                if(ticksPerMicro == 0) ticksPerMicro = 1;
+                printRowName(0, "Loop");
+            }
+            continue;
+        }
+        char kind;
+        unsigned int id, event;
+        unsigned long ticks;
+        int nameAt = 0;
+        if(strcmp(line, "#ENDTRACE") == 0) {
+            done = true;
+        } else if(sscanf(line, "#NAME %c %u %n", &kind, &id, &nameAt) == 2 && nameAt > 0) {
+            printRowName((kind == 'B')? BUTTON_ROW + id: (long) id, line + nameAt);
+        } else if(sscanf(line, "#T %lu %u %u", &ticks, &event, &id) == 3) {
+            // ticks are 32 bits and wrap, only differences count //
+            if(haveTicks) {
+                ts += (double) ((ticks - lastTicks) & 0xFFFFFFFFUL) / ticksPerMicro;
+            }
+            lastTicks = ticks;
+            haveTicks = true;
+            id &= MAX_IDS - 1;
+            switch(event) {
+                case TraceEvent_Loop:
+                    if(inLoop) {
+                        beginEvent("E", 0, ts);
+                        printf("}");
+                    }
+                    beginEvent("B", 0, ts);
+                    printf(",\"name\":\"loop\"}");
+                    inLoop = true;
+                    break;
+                case TraceEvent_CommandStart:
+                    printInstant("start", id, ts);
+                    break;
+                case TraceEvent_CommandInitialize:
+                    beginEvent("B", id, ts);
+                    printf(",\"name\":\"run\"}");
+                    openCount[id]++;
+                    break;
+                case TraceEvent_CommandEnd:
+                case TraceEvent_CommandInterrupted:
+                    // the matching initialize may have been overwritten //
+                    if(openCount[id] == 0) break;
+                    openCount[id]--;
+                    beginEvent("E", id, ts);
+                    printf(",\"args\":{\"result\":\"%s\"}}",
+                           (event == TraceEvent_CommandEnd)? "end": "interrupted");
+                    break;
+                case TraceEvent_CommandPreempted:
+                    printInstant("preempted", id, ts);
+                    break;
+                case TraceEvent_ButtonPressed:
+                case TraceEvent_ButtonReleased:
+                    printInstant((event == TraceEvent_ButtonPressed)? "pressed": "released",
+                                 BUTTON_ROW + id, ts);
+                    break;
+            }
+        }
+    }
+    // close whatever was still running when the trace was taken //
+    unsigned int id;
+    for(id = 0; id < MAX_IDS; id++) {
+        for(; openCount[id] > 0; openCount[id]--) {
+            beginEvent("E", id, ts);
+            printf("}");
+        }
+    }
+    if(inLoop) {
+        beginEvent("E", 0, ts);
+        printf("}");
+    }
+    printf("\n]}\n");
+    if(!inTrace) fprintf(stderr, "trace2chrome: no #TRACE block found\n");
+    return (inTrace)? 0: 1;
+}
@@ -0,0 +1,46 @@
+//
+//  Arena.h
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#ifndef _Arena_h
+#define _Arena_h
+
+#include "VexOS.h"
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+// the arena grows from the heap in chunks until it is sealed, when  //
+// the robot is first enabled. After that nothing is ever freed, and //
+// each Arena_alloc() falls back to the heap and is counted; a BENCH //
+// or DEBUG build raises an error instead                            //
+#define ARENA_CHUNK_SIZE    1024
+#define ARENA_ALIGNMENT     8
+
+void*  Arena_alloc(size_t size);
+void   Arena_seal();
+bool   Arena_isSealed();
+size_t Arena_getUsed();
+size_t Arena_getFree();
+void   Arena_noteHeapUse(size_t size);
+unsigned long Arena_getHeapAllocs();
+
+#endif // _Arena_h
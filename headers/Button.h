@@ -45,6 +45,7 @@ struct Button {
 
 void Button_executeScheduler(ButtonScheduler* sched);
 Button* Button_getSchedulerButton(ButtonScheduler* sched);
+void Button_deleteScheduler(ButtonScheduler* sched);
 
 void Button_setvName(Button* button, String fmtString, va_list argp);
 void Button_setvArgs(Button* button, String fmrString, va_list argp);
@@ -0,0 +1,52 @@
+//
+//  Clock.h
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#ifndef _Clock_h
+#define _Clock_h
+
+#include "VexOS.h"
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+// ticks are free-running and wrap, so only differences are valid; //
+// this is the default source's resolution, Clock_setSource() can   //
+// replace it, so convert with Clock_getTicksPerMicro()              //
+#ifdef __arm__
+  // Cortex-M3 DWT cycle counter at the 72MHz core clock //
+  #define CLOCK_TICKS_PER_MICROSECOND   72
+#else
+  // host builds fall back to the millisecond easyC clock //
+  #define CLOCK_TICKS_PER_MICROSECOND   1
+#endif
+
+// a replacement tick source, such as a host clock, and its resolution; //
+// set it before VexOS starts, the loop period is kept in ticks          //
+typedef unsigned long (ClockSource)();
+
+void          Clock_initialize();
+void          Clock_setSource(ClockSource* source, unsigned long ticksPerMicro);
+unsigned long Clock_getTicks();
+unsigned long Clock_getTicksPerMicro();
+unsigned long Clock_ticksToMicros(unsigned long ticks);
+
+#endif // _Clock_h
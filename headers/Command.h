@@ -23,6 +23,28 @@
 #define _Command_h
 
 #include "VexOS.h"
+#include "TimerWheel.h"
+
+// unset startTime or timeout, both are in milliseconds //
+#define COMMAND_TIME_NONE   ((unsigned long) -1)
+// longest name formatted, including arguments //
+#define COMMAND_NAME_MAX    64
+// most name and argument values kept per Command //
+#define COMMAND_MAX_ARGS    4
+
+/********************************************************************
+ * Command Name Arguments                                           *
+ ********************************************************************/
+
+// names are kept unformatted, so the format strings must be static. //
+// A name with a %s argument is formatted when set, as the string may //
+// not outlive the call; %@ takes a Command and formats its name      //
+typedef union {
+    long                longValue;
+    long long           longLongValue;
+    float               floatValue;
+    const void*         pointerValue;
+} CommandArg;
 
 /********************************************************************
  * Command Structure                                                *
@@ -35,14 +57,34 @@ struct Command {
     // hidden infrastructure fields //
     unsigned int        objectId;
     unsigned int        instanceId;
-    String              name;
+    String              nameFmt;
+    String              argsFmt;
+    unsigned char       nameArgCount;
+    unsigned char       argCount;
+    CommandArg          args[COMMAND_MAX_ARGS];
+    // names formatted when set are kept here, and it is kept on reuse //
+    char*               nameText;
+    unsigned char       nameTextSize;
     Command*            parent;
     CommandStatus       status;
-    float               startTime;
-    float               timeout;
+    unsigned long       startTime;
+    unsigned long       timeout;
+    // set by a CommandGroup step, cancels after this many ms //
+    unsigned long       cancelAfter;
+    unsigned long       wakeTime;
+    // multi-rate Commands sleep this many ms between executes //
+    unsigned long       period;
+    // fires at the earliest of the times above //
+    WheelTimer          timer;
     bool                interruptible;
     bool                runWhenDisabled;
-    List                requiresList;
+    unsigned char       priority;
+    unsigned long       requireMask;
+    // scheduler links, the Command is its own list node //
+    ListNode            runNode;
+    ListNode            queueNode;
+    // execution timing, only allocated when profiling //
+    struct CommandProfile* profile;
 };
 
 /********************************************************************
@@ -50,16 +92,21 @@ struct Command {
  ********************************************************************/
 
 void Command_constructor(Command* cmd);
+Command* Command_allocate(CommandClass* class);
 bool Command_run(Command* cmd);
-void Command_startRunning(Command* cmd);
+void Command_startRunning(Command* cmd, unsigned long cancelAfter);
 void Command_removed(Command* cmd);
 void Command_setCancelled(Command* cmd);
+void Command_setParent(Command* cmd, Command* group);
+unsigned long Command_msSinceInitialized(Command* cmd);
+unsigned long Command_secondsToMs(float seconds);
 
 void Command_setvName(Command* cmd, String fmtString, va_list argp);
 void Command_setvArgs(Command* cmd, String fmtString, va_list argp);
 void Command_require(Command* cmd, Subsystem* sys);
 void Command_setTimeout(Command* cmd, float timeoutSec);
 bool Command_isTimedOut(Command* cmd);
+void Command_sleepUntil(Command* cmd, unsigned long timeMs);
 void Command_setInterruptible(Command* cmd, bool value);
 void Command_checkInstance(Command* cmd, CommandClass* class);
 
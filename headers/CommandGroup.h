@@ -31,21 +31,29 @@
 // group entry type code //
 typedef enum {
     GroupEntryState_InSequence,
-    GroupEntryState_BranchPeer,
-    GroupEntryState_BranchChild
+    GroupEntryState_BranchChild,
+    GroupEntryState_RaceMember,
+    GroupEntryState_Deadline
 } GroupEntryState;
 
-// group entry structure //
-typedef struct GroupEntry GroupEntry;
-struct GroupEntry {
+// one step of a group, sealed into the arena on first start or when //
+// the arena is sealed, whichever comes first                         //
+typedef struct GroupStep GroupStep;
+struct GroupStep {
     Command*        command;
-    GroupEntryState state;
-    float           timeout;
+    unsigned long   timeout;
+    unsigned long   requireMask;
+    // step after this one: the end of its parallel span or race //
+    unsigned short  next;
+    unsigned char   state;
+    bool            running;
 };
 
 bool        CommandGroup_isGroup(Command* cmd);
 bool        CommandGroup_isInterruptible(Command* group);
 Command*    CommandGroup_getCurrentCommand(Command* group);
-const List* CommandGroup_getChildList(Command* group);
+unsigned int CommandGroup_getChildCount(Command* group);
+Command*    CommandGroup_getChild(Command* group, unsigned int index);
+void        CommandGroup_sealAll();
 
 #endif
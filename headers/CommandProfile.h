@@ -0,0 +1,42 @@
+//
+//  CommandProfile.h
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#ifndef _CommandProfile_h
+#define _CommandProfile_h
+
+#include "VexOS.h"
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+#define COMMAND_PHASE_COUNT     3
+
+typedef struct CommandProfile CommandProfile;
+
+// checked by Command_run() before timing each method //
+extern bool CommandProfileEnabled;
+
+void CommandProfile_add(Command* cmd);
+void CommandProfile_record(Command* cmd, CommandPhase phase, unsigned long ticks);
+void CommandProfile_remove(Command* cmd);
+
+#endif // _CommandProfile_h
@@ -44,7 +44,8 @@ typedef enum {
     VEXOS_COMMANDLOCK,
     VEXOS_BUTTONLOCK,
     VEXOS_OBJTYPE,
-    VEXOS_NOTINITIALIZED
+    VEXOS_NOTINITIALIZED,
+    VEXOS_NOMEMORY
 } ErrorCode;
 
 void   Error_setCode(ErrorCode code);
@@ -0,0 +1,49 @@
+//
+//  Histogram.h
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#ifndef _Histogram_h
+#define _Histogram_h
+
+#include "VexOS.h"
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+// two buckets per power of two, values of 2^16 and above share the //
+// last bucket. Bucket counts are halved together when one fills,   //
+// which keeps the shape of the distribution for percentiles        //
+#define HISTOGRAM_BUCKETS   32
+
+typedef struct {
+    unsigned long      count;
+    unsigned long      min;
+    unsigned long      max;
+    unsigned long long total;
+    unsigned short     buckets[HISTOGRAM_BUCKETS];
+} Histogram;
+
+void          Histogram_reset(Histogram* hist);
+void          Histogram_add(Histogram* hist, unsigned long value);
+unsigned long Histogram_getMean(const Histogram* hist);
+unsigned long Histogram_getPercentile(const Histogram* hist, unsigned int percent);
+
+#endif // _Histogram_h
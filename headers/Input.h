@@ -0,0 +1,40 @@
+//
+//  Input.h
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#ifndef _Input_h
+#define _Input_h
+
+#include "VexOS.h"
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+// channels are added to the snapshot the first time they are read //
+void          Input_sample();
+int           Input_getJoystickAnalog(unsigned char joystick, unsigned char channel);
+bool          Input_getJoystickDigital(unsigned char joystick, unsigned char channel, 
+                                       unsigned char button);
+int           Input_getJoystickAccelerometer(unsigned char joystick, unsigned char axis);
+bool          Input_getDigital(unsigned char port);
+unsigned int  Input_getAnalog(unsigned char port);
+
+#endif // _Input_h
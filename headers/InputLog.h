@@ -0,0 +1,73 @@
+//
+//  InputLog.h
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#ifndef _InputLog_h
+#define _InputLog_h
+
+#include "VexOS.h"
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+// every raw read the library makes has a channel, numbered by port //
+typedef enum {
+    InputChannel_JoystickAnalog  = 0,     // + (joystick - 1) * 4 + channel - 1
+    InputChannel_JoystickAccel   = 8,     // + (joystick - 1) * 2 + axis - 1
+    InputChannel_JoystickDigital = 12,    // + (joystick - 1) * 32 + (channel - 5) * 8 + button
+    InputChannel_Digital         = 76,    // + port - 1
+    InputChannel_AnalogHR        = 88,    // + port - 1
+    InputChannel_Analog          = 96,    // + port - 1
+    InputChannel_Encoder         = 104,   // + port A - 1
+    InputChannel_Gyro            = 116,   // + port - 1
+    InputChannel_Sonar           = 124,   // + input port - 1
+    InputChannel_ImeCounter      = 136,   // + ime
+    InputChannel_ImeSpeed        = 146,   // + ime
+    InputChannel_Enabled         = 156,
+    InputChannel_Clock           = 157,   // microseconds since the last latch
+    InputChannel_Idle            = 158,   // a paced loop had time left over
+    InputChannel_Timer           = 159,   // + timer - 1
+    InputChannel_MainBattery     = 165,   // millivolts
+    InputChannel_BackupBattery   = 166,   // millivolts
+    InputChannel_Count
+} InputChannel;
+
+// compiled out entirely unless built with INPUTLOG //
+#ifdef INPUTLOG
+  #define LogInput(channel, read)   InputLog_read(channel, read)
+  #define LogRun(mode)              InputLog_startRun(mode)
+  #define LogInterruptBegin()       InputLog_beginInterrupt()
+  #define LogInterruptEnd()         InputLog_endInterrupt()
+  bool InputLog_isReplaying();
+#else
+  #define LogInput(channel, read)   (read)
+  #define LogRun(mode)
+  #define LogInterruptBegin()
+  #define LogInterruptEnd()
+  #define InputLog_isReplaying()    false
+#endif
+
+long InputLog_read(InputChannel channel, long value);
+void InputLog_startRun(RunMode mode);
+void InputLog_beginInterrupt();
+void InputLog_endInterrupt();
+
+#endif // _InputLog_h
@@ -28,16 +28,21 @@
  * Protected API                                                    *
  ********************************************************************/
 
-#define MAX_INTERRUPT_HANDLERS      10
+#define MAX_INTERRUPT_HANDLERS      10  // at most 16, one bit each per slot
 #define INTERRUPT_FREQ_HZ           50
 #define INTERRUPT_PERIOD_SECONDS    (1.0 / INTERRUPT_FREQ_HZ)
+// handlers run every freq ticks; freq must divide the frame //
+#define INTERRUPT_FRAME_SLOTS       120
 
 typedef void (InterruptHandler)(void* object);
 
 bool Interrupt_isEnabled();
 void Interrupt_enable();
 void Interrupt_disable();
-void Interrupt_add(void* object, InterruptHandler* handler, int freq, int order);
+void Interrupt_add(void* object, InterruptHandler* handler, String name, int freq, int order);
+void Interrupt_addWithPhase(void* object, InterruptHandler* handler, String name, int freq,
+                            int phase, int order);
 void Interrupt_remove(void* object, InterruptHandler* handler);
+void Interrupt_run();
 
 #endif // _Interrupt_h
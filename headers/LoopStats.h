@@ -0,0 +1,44 @@
+//
+//  LoopStats.h
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#ifndef _LoopStats_h
+#define _LoopStats_h
+
+#include "VexOS.h"
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+typedef enum {
+    LoopPhase_Scheduler,
+    LoopPhase_Events,
+    LoopPhase_UI,
+    LoopPhase_Idle
+} LoopPhase;
+
+#define LOOP_PHASE_COUNT    4
+
+void LoopStats_start();
+void LoopStats_beginLoop();
+void LoopStats_mark(LoopPhase phase);
+
+#endif // _LoopStats_h
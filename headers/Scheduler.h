@@ -30,8 +30,22 @@
 
 typedef struct ButtonScheduler ButtonScheduler;
 
+// nodes walked each loop, only counted in builds with BENCH //
+#ifdef BENCH
+  extern unsigned long Scheduler_visits;
+  #define CountVisit()  (Scheduler_visits++)
+#else
+  #define CountVisit()
+#endif
+
 void Scheduler_run();
+void Scheduler_resetDefaults();
+void Scheduler_wakeDefault(Subsystem* sys);
 void Scheduler_add(Command* cmd);
+void Scheduler_wake(Command* cmd);
+void Scheduler_wakeAll();
+void Scheduler_setPriority(Command* cmd, CommandPriority priority);
+bool Scheduler_isScheduled(Command* cmd);
 void Scheduler_addButtonScheduler(ButtonScheduler* sched);
 void Scheduler_removeButtonSchedulers(Button* button);
 
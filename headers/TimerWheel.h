@@ -0,0 +1,51 @@
+//
+//  TimerWheel.h
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#ifndef _TimerWheel_h
+#define _TimerWheel_h
+
+#include "VexOS.h"
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+// four levels of 32 slots at 1ms, covering about 17 minutes; longer //
+// timers wait in the last level and are placed again as it turns   //
+#define TIMERWHEEL_LEVELS       4
+#define TIMERWHEEL_SLOT_BITS    5
+#define TIMERWHEEL_SLOTS        (1 << TIMERWHEEL_SLOT_BITS)
+
+typedef struct WheelTimer WheelTimer;
+struct WheelTimer {
+    ListNode      node;
+    unsigned long expires;
+    void        (*handler)(WheelTimer* timer);
+    void*         data;
+};
+
+void          TimerWheel_add(WheelTimer* timer, unsigned long expires);
+void          TimerWheel_remove(WheelTimer* timer);
+bool          TimerWheel_isPending(WheelTimer* timer);
+void          TimerWheel_advance(unsigned long timeMs);
+unsigned long TimerWheel_getTime();
+
+#endif // _TimerWheel_h
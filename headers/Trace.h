@@ -0,0 +1,64 @@
+//
+//  Trace.h
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#ifndef _Trace_h
+#define _Trace_h
+
+#include "VexOS.h"
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+// records kept, oldest are overwritten; must be a power of two //
+#ifndef TRACE_CAPACITY
+  #define TRACE_CAPACITY    256
+#endif
+
+typedef enum {
+    TraceEvent_Loop,
+    TraceEvent_CommandStart,
+    TraceEvent_CommandInitialize,
+    TraceEvent_CommandEnd,
+    TraceEvent_CommandInterrupted,
+    TraceEvent_CommandPreempted,
+    TraceEvent_ButtonPressed,
+    TraceEvent_ButtonReleased
+} TraceEvent;
+
+// object is only used to name the record when it is dumped //
+typedef struct {
+    unsigned long  ticks;
+    const void*    object;
+    unsigned short objectId;
+    unsigned char  event;
+} TraceRecord;
+
+// compiled out entirely unless built with TRACE //
+#ifdef TRACE
+  #define Trace(event, object, objectId) Trace_record(event, object, objectId)
+#else
+  #define Trace(event, object, objectId)
+#endif
+
+void Trace_record(TraceEvent event, const void* object, unsigned int objectId);
+
+#endif // _Trace_h
@@ -42,4 +42,8 @@ void Device_setPWMExpander(PWMPort, PowerExpander*);
 void Device_addUART(UARTPort, Device*);
 void Device_addVirtualDevice(Device*);
 
+// live reads that bypass the Input snapshot, for interrupt handlers //
+bool  DigitalIn_read(DigitalIn*);
+float AnalogIn_read(AnalogIn*);
+
 #endif // _Device_h
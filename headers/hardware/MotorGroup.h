@@ -31,6 +31,8 @@
 
 typedef void (SpeedHandler)(MotorGroup* group);
 
+// only what the main loop uses, the control ISR's state is kept in //
+// arrays in MotorGroup.c, indexed by slot                          //
 struct MotorGroup {
     // device header //
     unsigned char  deviceId;
@@ -39,27 +41,11 @@ struct MotorGroup {
     Subsystem*     subsystem;
     // device item fields //
     List           children;
-    volatile Power powerActual;
-    Power          powerRequested;
     Power          powerDeadbandMin;
     Power          powerDeadbandMax;
-    Power          powerSlewRate;
     float          outputScale;
-    bool           feedbackEnabled;
-    FeedbackType   feedbackType;
-    Device*        feedbackDevice;
-    float          feedbackScale;
-    DigitalIn*     limitSwitchRev;
-    DigitalIn*     limitSwitchFwd;
-    volatile float position;
-    volatile float lastPosition;
-    volatile float speed;
-    int            speedCycle;
-    SpeedHandler*  speedHandler;
-    bool           pidEnabled;
-    PIDState       pid;
     float          pidTolerance;
-    unsigned char  globaldataSlot;
+    unsigned short slot;
 };
 
 SpeedHandler* MotorGroup_getSpeedHandler(MotorGroup* group);
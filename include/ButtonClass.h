@@ -28,6 +28,7 @@
  * ButtonClass Structures                                           *
  ********************************************************************/
 
+// a NULL selfPtr means methods are given self as their first argument //
 struct ButtonClass {
     bool         initialized;
     String const name;
@@ -86,6 +87,37 @@ struct Button {
         Button_checkInstance(button, &xclass); \
     }
 
+// reentrant classes get self as an argument, no static self is swapped //
+#define DefineReentrantButtonClass(xclass, ...) \
+    static void constructor(Button* self, va_list argp); \
+    static bool get(Button* self); \
+    typedef struct Fields __VA_ARGS__ Fields; \
+    ButtonClass xclass = { \
+        .name        = #xclass, \
+        .selfPtr     = NULL, \
+        .fieldSize   = sizeof(struct Fields), \
+        .constructor = (void (*)(va_list)) &constructor, \
+        .get         = &get \
+    }; \
+    void Button_setvName(Button*, String fmtString, va_list argp); \
+    static void setName(Button* self, String fmtString, ...) { \
+        va_list argp; \
+        va_start(argp, fmtString); \
+        Button_setvName(self, fmtString, argp); \
+        va_end(argp); \
+    } \
+    void Button_setvArgs(Button* button, String fmtString, va_list argp); \
+    static void setArgs(Button* self, String fmtString, ...) { \
+        va_list argp; \
+        va_start(argp, fmtString); \
+        Button_setvArgs(self, fmtString, argp); \
+        va_end(argp); \
+    } \
+    void Button_checkInstance(Button* button, ButtonClass* class); \
+    static void checkInstance(Button* button) { \
+        Button_checkInstance(button, &xclass); \
+    }
+
 /********************************************************************
  * GCC Compiler Pragmas                                             *
  ********************************************************************/
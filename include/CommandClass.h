@@ -28,12 +28,14 @@
  * CommandClass Structures                                          *
  ********************************************************************/
 
+// a NULL selfPtr means methods are given self as their first argument //
 struct CommandClass {
     bool         initialized;
     String const name;
     Command**    selfPtr;
     size_t       fieldSize;
     unsigned int lastInstanceId;
+    Command*     freeList;
     // Command methods //
     void (*constructor)(va_list);
     void (*destructor)();
@@ -47,6 +49,15 @@ struct CommandClass {
     Command** groupSelfPtr;
 };
 
+// resume point and wait state of a DefineCoroutineCommand //
+#define COROUTINE_DONE  0xFFFF
+
+typedef struct {
+    unsigned short line;
+    unsigned long  wakeTime;
+    Command*       awaiting;
+} Coroutine;
+
 /********************************************************************
  * Command Structure (public version)                               *
  ********************************************************************/
@@ -108,6 +119,19 @@ struct Command {
     static bool isTimedOut() { \
         return Command_isTimedOut(self); \
     } \
+    void Command_sleepUntil(Command* cmd, unsigned long timeMs); \
+    static void sleepUntil(unsigned long timeMs) { \
+        Command_sleepUntil(self, timeMs); \
+    } \
+    static void sleepUntilTimedOut() { \
+        Command_sleepUntil(self, (unsigned long) -1); \
+    } \
+    static void setPeriod(float seconds) { \
+        Command_setPeriod(self, seconds); \
+    } \
+    static void setPriority(CommandPriority priority) { \
+        Command_setPriority(self, priority); \
+    } \
     void Command_setInterruptible(Command* cmd, bool value); \
     static void setInterruptible(bool value) { \
         Command_setInterruptible(self, value); \
@@ -117,6 +141,165 @@ struct Command {
         Command_checkInstance(cmd, &xclass); \
     }
 
+// helpers shared by the classes whose methods are given self //
+#define ReentrantCommandHelpers(xclass) \
+    void Command_setvName(Command* cmd, String fmtString, va_list argp); \
+    static void setName(Command* self, String fmtString, ...) { \
+        va_list argp; \
+        va_start(argp, fmtString); \
+        Command_setvName(self, fmtString, argp); \
+        va_end(argp); \
+    } \
+    void Command_setvArgs(Command* cmd, String fmtString, va_list argp); \
+    static void setArgs(Command* self, String fmtString, ...) { \
+        va_list argp; \
+        va_start(argp, fmtString); \
+        Command_setvArgs(self, fmtString, argp); \
+        va_end(argp); \
+    } \
+    void Command_require(Command* cmd, Subsystem* sys); \
+    static void require(Command* self, Subsystem* sys) { \
+        Command_require(self, sys); \
+    } \
+    void Command_setTimeout(Command* cmd, float timeoutSec); \
+    static void setTimeout(Command* self, float timeoutSec) { \
+        Command_setTimeout(self, timeoutSec); \
+    } \
+    bool Command_isTimedOut(Command* cmd); \
+    static bool isTimedOut(Command* self) { \
+        return Command_isTimedOut(self); \
+    } \
+    void Command_sleepUntil(Command* cmd, unsigned long timeMs); \
+    static void sleepUntil(Command* self, unsigned long timeMs) { \
+        Command_sleepUntil(self, timeMs); \
+    } \
+    static void sleepUntilTimedOut(Command* self) { \
+        Command_sleepUntil(self, (unsigned long) -1); \
+    } \
+    static void setPeriod(Command* self, float seconds) { \
+        Command_setPeriod(self, seconds); \
+    } \
+    static void setPriority(Command* self, CommandPriority priority) { \
+        Command_setPriority(self, priority); \
+    } \
+    void Command_setInterruptible(Command* cmd, bool value); \
+    static void setInterruptible(Command* self, bool value) { \
+        Command_setInterruptible(self, value); \
+    } \
+    void Command_checkInstance(Command* cmd, CommandClass* class); \
+    static void checkInstance(Command* cmd) { \
+        Command_checkInstance(cmd, &xclass); \
+    }
+
+// reentrant classes get self as an argument, no static self is swapped //
+#define DefineReentrantCommandClass(xclass, ...) \
+    static void constructor(Command* self, va_list argp); \
+    static void initialize(Command* self); \
+    static void execute(Command* self); \
+    static bool isFinished(Command* self); \
+    static void end(Command* self); \
+    static void interrupted(Command* self); \
+    typedef struct Fields __VA_ARGS__ Fields; \
+    CommandClass xclass = { \
+        .name        = #xclass, \
+        .selfPtr     = NULL, \
+        .fieldSize   = sizeof(struct Fields), \
+        .constructor = (void (*)(va_list)) &constructor, \
+        .initialize  = &initialize, \
+        .execute     = &execute, \
+        .isFinished  = &isFinished, \
+        .end         = &end, \
+        .interrupted = &interrupted \
+    }; \
+    ReentrantCommandHelpers(xclass)
+
+// a stackless coroutine: routine() is the execute method and resumes //
+// where it last yielded. Locals do not survive a yield, keep them in  //
+// the fields. Only one yield per source line, and no switch around a  //
+// yield. Awaited Commands should be made once, in the constructor,    //
+// and may only require Subsystems the coroutine requires itself       //
+#define DefineCoroutineCommand(xclass, ...) \
+    static void constructor(Command* self, va_list argp); \
+    static void routine(Command* self); \
+    static void end(Command* self); \
+    static void interrupted(Command* self); \
+    static void coroutineInitialize(Command* self); \
+    static bool coroutineIsFinished(Command* self); \
+    static void coroutineEnd(Command* self); \
+    static void coroutineInterrupted(Command* self); \
+    typedef struct Fields { \
+        Coroutine coroutine; \
+        struct __VA_ARGS__; \
+    } Fields; \
+    CommandClass xclass = { \
+        .name        = #xclass, \
+        .selfPtr     = NULL, \
+        .fieldSize   = sizeof(struct Fields), \
+        .constructor = (void (*)(va_list)) &constructor, \
+        .initialize  = &coroutineInitialize, \
+        .execute     = &routine, \
+        .isFinished  = &coroutineIsFinished, \
+        .end         = &coroutineEnd, \
+        .interrupted = &coroutineInterrupted \
+    }; \
+    void Coroutine_reset(Coroutine* co); \
+    void Coroutine_stop(Coroutine* co); \
+    void Coroutine_await(Command* cmd, Coroutine* co, Command* child); \
+    bool Coroutine_poll(Coroutine* co); \
+    static void coroutineInitialize(Command* self) { \
+        Coroutine_reset(&self->fields->coroutine); \
+    } \
+    static bool coroutineIsFinished(Command* self) { \
+        return (self->fields->coroutine.line == COROUTINE_DONE); \
+    } \
+    static void coroutineEnd(Command* self) { \
+        Coroutine_stop(&self->fields->coroutine); \
+        end(self); \
+    } \
+    static void coroutineInterrupted(Command* self) { \
+        Coroutine_stop(&self->fields->coroutine); \
+        interrupted(self); \
+    } \
+    ReentrantCommandHelpers(xclass)
+
+#define COROUTINE_BEGIN() \
+    Coroutine* coroutine = &self->fields->coroutine; \
+    switch(coroutine->line) { \
+        case 0:
+
+#define COROUTINE_END() \
+    } \
+    coroutine->line = COROUTINE_DONE
+
+#define YIELD() \
+    do { \
+        coroutine->line = __LINE__; \
+        return; \
+        case __LINE__:; \
+    } while(0)
+
+#define YIELD_UNTIL(cond) \
+    do { \
+        coroutine->line = __LINE__; \
+        case __LINE__: \
+        if(!(cond)) return; \
+    } while(0)
+
+// sleeps, so the Scheduler skips the routine until the time is up //
+#define WAIT_MS(ms) \
+    do { \
+        coroutine->wakeTime = VexOS_getRunTimeMs() + (ms); \
+        Command_sleepUntil(self, coroutine->wakeTime); \
+        YIELD_UNTIL((long) (VexOS_getRunTimeMs() - coroutine->wakeTime) >= 0); \
+    } while(0)
+
+// runs the Command inside this one, like a CommandGroup step //
+#define AWAIT(cmd) \
+    do { \
+        Coroutine_await(self, coroutine, (cmd)); \
+        YIELD_UNTIL(!Coroutine_poll(coroutine)); \
+    } while(0)
+
 #define DefineCommandGroup(xclass) \
     static void constructor(va_list argp); \
     static Command* self; \
@@ -38,16 +38,21 @@ struct Subsystem {
     void (*constructor)();
     void (*initialize)();
     // internal fields //
-    Command* currentCommand;
-    Command* defaultCommand;
-    bool     isEnabled;
+    Command*      currentCommand;
+    Command*      defaultCommand;
+    bool          isEnabled;
+    unsigned long requireBit;
 };
 
 /********************************************************************
  * Protected API: Subsystem                                         *
  ********************************************************************/
 
-extern List Subsystems;
+// one requirement bit per Subsystem, assigned at construction //
+#define MAX_SUBSYSTEMS  32
+
+extern List       Subsystems;
+extern Subsystem* SubsystemTable[MAX_SUBSYSTEMS];
 
 void Subsystem_setDefaultCommand(Subsystem* sys, Command* cmd);
 
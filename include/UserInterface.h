@@ -154,6 +154,30 @@ LCDScreen*  Battery_getLCDScreen();
 
 Window* Scheduler_getWindow();
 
+/********************************************************************
+ * Public API: CommandProfile (UI Hook)                             *
+ ********************************************************************/
+
+Window* CommandProfile_getWindow();
+
+/********************************************************************
+ * Public API: Interrupt (UI Hook)                                  *
+ ********************************************************************/
+
+Window* Interrupt_getWindow();
+
+/********************************************************************
+ * Public API: Task (UI Hook)                                       *
+ ********************************************************************/
+
+Window* Task_getWindow();
+
+/********************************************************************
+ * Public API: LoopStats (UI Hook)                                  *
+ ********************************************************************/
+
+Window* LoopStats_getWindow();
+
 /********************************************************************
  * Public API: Status (UI Hook)                                     *
  ********************************************************************/
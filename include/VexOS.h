@@ -79,6 +79,7 @@ typedef struct PowerScaler   PowerScaler;
 typedef struct DebugValue    DebugValue;
 typedef struct PIDController PIDController;
 typedef struct Timer         Timer;
+typedef struct Task          Task;
 
 // scalar types //
 typedef const char* String;
@@ -95,7 +96,7 @@ typedef enum {
     RunMode_Operator
 } RunMode;
 
-#define EVENT_COUNT     8
+#define EVENT_COUNT     9
 
 typedef enum {
     EventType_Initialize,
@@ -105,7 +106,8 @@ typedef enum {
     EventType_AutonomousPeriodic,
     EventType_OperatorStart,
     EventType_OperatorPeriodic,
-    EventType_SystemError
+    EventType_SystemError,
+    EventType_Idle
 } EventType;
 
 typedef void (EventHandler)(EventType, void*);
@@ -114,10 +116,35 @@ typedef void (EventHandler)(EventType, void*);
 RunMode       VexOS_getRunMode();
 RunMode       VexOS_getLastRunMode();
 unsigned long VexOS_getRunTime();
+unsigned long VexOS_getRunTimeMs();
+unsigned long VexOS_getRunTimeMicros();
 float         VexOS_getLoopFrequency();
+void          VexOS_setLoopFrequency(unsigned int hz);
 String        VexOS_getProgramName();
 void          VexOS_setProgramName(String name);
 
+// loop timing, all times are in microseconds //
+typedef struct {
+    unsigned long loops;
+    unsigned long minMicros;
+    unsigned long meanMicros;
+    unsigned long maxMicros;
+    unsigned long p50Micros;
+    unsigned long p99Micros;
+    unsigned long jitterMicros;
+    unsigned long budgetMicros;
+    unsigned long overruns;
+    unsigned long schedulerMicros;
+    unsigned long eventsMicros;
+    unsigned long uiMicros;
+    unsigned long idleMicros;
+    float         idleFraction;
+} LoopStats;
+
+void VexOS_getLoopStats(LoopStats* stats);
+void VexOS_resetLoopStats();
+void VexOS_setLoopBudget(unsigned long micros);
+
 // event handling //
 bool VexOS_addEventHandler(EventType type, EventHandler* handler, void* state);
 bool VexOS_removeEventHandler(EventType type, EventHandler* handler);
@@ -160,6 +187,10 @@ void Battery_getBackupThresholds(float* threshG, float* threshY);
 
 String CommandClass_getName(CommandClass* class);
 bool   CommandClass_isInitialized(CommandClass* class);
+// Commands are allocated from an arena sealed when the robot is first //
+// enabled; reserve the Commands a class creates during a match, or     //
+// each one then comes from the heap and is counted on the Status window //
+void   CommandClass_reserve(CommandClass* class, unsigned int count);
 
 /********************************************************************
  * Public API: Command                                              *
@@ -169,23 +200,114 @@ typedef enum {
     CommandStatus_Running     = 0x01,
     CommandStatus_Cancelled   = 0x02,
     CommandStatus_Locked      = 0x04,
-    CommandStatus_Initialized = 0x08
+    CommandStatus_Initialized = 0x08,
+    CommandStatus_Held        = 0x10,
+    CommandStatus_TimedOut    = 0x20,
+    CommandStatus_Sleeping    = 0x40
 } CommandStatus;
 
+// higher priorities run first each loop, and preempt lower ones //
+// even when those aren't interruptible                            //
+typedef enum {
+    CommandPriority_Low,
+    CommandPriority_Normal,
+    CommandPriority_High,
+    CommandPriority_Critical
+} CommandPriority;
+
+#define COMMAND_PRIORITY_COUNT  4
+
 Command*      Command_new(CommandClass* class, ...);
 Command*      Command_delete(Command* cmd);
 void          Command_start(Command* cmd);
 void          Command_cancel(Command* cmd);
 String        Command_getName(Command* cmd);
+int           Command_formatName(Command* cmd, char* buffer, size_t size);
 CommandClass* Command_getClass(Command* cmd);
 Command*      Command_getParent(Command* cmd);
 CommandStatus Command_getStatus(Command* cmd);
 bool          Command_isInterruptible(Command* cmd);
 bool          Command_runWhenDisabled(Command* cmd);
 void          Command_setRunWhenDisabled(Command* cmd, bool value);
+void          Command_setPeriod(Command* cmd, float seconds);
+CommandPriority Command_getPriority(Command* cmd);
+void          Command_setPriority(Command* cmd, CommandPriority priority);
 bool          Command_doesRequireSubsystem(Command* cmd, Subsystem* sys);
 float         Command_timeSinceInitialized(Command* cmd);
 
+/********************************************************************
+ * Public API: CommandProfile                                       *
+ ********************************************************************/
+
+typedef enum {
+    CommandPhase_Initialize,
+    CommandPhase_Execute,
+    CommandPhase_IsFinished
+} CommandPhase;
+
+typedef struct {
+    unsigned long count;
+    unsigned long minMicros;
+    unsigned long meanMicros;
+    unsigned long maxMicros;
+    unsigned long p99Micros;
+} CommandProfileStats;
+
+// enable during setup: profiles come from the arena, and Commands first //
+// timed after it is sealed share a few spares, then go unprofiled       //
+void CommandProfile_setEnabled(bool value);
+bool CommandProfile_isEnabled();
+void CommandProfile_reset();
+bool CommandProfile_getStats(Command* cmd, CommandPhase phase, CommandProfileStats* stats);
+
+/********************************************************************
+ * Public API: Interrupt                                            *
+ ********************************************************************/
+
+// every interrupt tick, all times are in microseconds //
+typedef struct {
+    unsigned long ticks;
+    unsigned long lastMicros;
+    unsigned long meanMicros;
+    unsigned long maxMicros;
+    unsigned long budgetMicros;
+    unsigned long overruns;
+} InterruptStats;
+
+// the ticks a single handler ran in //
+typedef struct {
+    String        name;
+    unsigned long count;
+    unsigned long lastMicros;
+    unsigned long meanMicros;
+    unsigned long maxMicros;
+} InterruptHandlerStats;
+
+void         Interrupt_setProfileEnabled(bool value);
+bool         Interrupt_isProfileEnabled();
+void         Interrupt_resetProfile();
+void         Interrupt_setBudget(unsigned long micros);
+void         Interrupt_getStats(InterruptStats* stats);
+unsigned int Interrupt_getHandlerCount();
+bool         Interrupt_getHandlerStats(unsigned int index, InterruptHandlerStats* stats);
+
+/********************************************************************
+ * Public API: Trace                                                *
+ ********************************************************************/
+
+void Trace_dump();
+void Trace_clear();
+
+/********************************************************************
+ * Public API: InputLog                                             *
+ ********************************************************************/
+
+// returns the next byte of a recorded log, or -1 at its end //
+typedef int (InputLogReader)(void* state);
+
+void InputLog_replay(InputLogReader* reader, void* state);
+bool InputLog_nextRun(RunMode* mode);
+
 /********************************************************************
  * Public API: CommandGroup                                         *
  ********************************************************************/
@@ -195,6 +317,8 @@ void CommandGroup_addSequential(Command* group, Command* cmd);
 void CommandGroup_addSequentialWithTimeout(Command* group, Command* cmd, float timeout);
 void CommandGroup_addParallel(Command* group, Command* cmd);
 void CommandGroup_addParallelWithTimeout(Command* group, Command* cmd, float timeout);
+void CommandGroup_addRace(Command* group, Command* cmd);
+void CommandGroup_addDeadline(Command* group, Command* cmd);
 
 /********************************************************************
  * Public API: ButtonClass                                          *
@@ -327,6 +451,33 @@ float   PIDController_getOutput(PIDController* pid);
 float   PIDController_getSetpoint(PIDController* pid);
 void    PIDController_setSetpoint(PIDController* pid, float setpoint);
 
+/********************************************************************
+ * Public API: Task                                                 *
+ ********************************************************************/
+
+// background work run at a fixed period from the idle phase, when //
+// several are due the earliest deadline runs first, then priority //
+typedef void (TaskHandler)(Task* task, void* state);
+
+typedef struct {
+    unsigned long runs;
+    unsigned long overruns;
+    unsigned long meanJitterMs;
+    unsigned long maxJitterMs;
+    unsigned long lastMicros;
+    unsigned long maxMicros;
+} TaskStats;
+
+Task*         Task_new(String name, unsigned long periodMs, unsigned char priority, 
+                       TaskHandler* handler, void* state);
+Task*         Task_delete(Task* task);
+String        Task_getName(Task* task);
+unsigned long Task_getPeriod(Task* task);
+void          Task_setPeriod(Task* task, unsigned long periodMs);
+bool          Task_isEnabled(Task* task);
+void          Task_setEnabled(Task* task, bool value);
+void          Task_getStats(Task* task, TaskStats* stats);
+
 /********************************************************************
  * Public API: Timer                                                  *
  ********************************************************************/
@@ -0,0 +1,92 @@
+//
+//  Arena.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#include "API.h"
+
+#include "Arena.h"
+#include "Error.h"
+
+/********************************************************************
+ * Private API                                                      *
+ ********************************************************************/
+
+static char*  chunk;
+static size_t chunkFree;
+static size_t used;
+static bool   sealed;
+static unsigned long heapAllocs;
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+// a bench or debug build stops at the first heap use after the seal, //
+// a match build counts it for the Status window and carries on       //
+void Arena_noteHeapUse(size_t size) {
+#if defined(BENCH) || defined(DEBUG)
+    ErrorMsgIf(true, VEXOS_NOMEMORY, "Arena is sealed, cannot allocate %d bytes", (int) size);
+#endif
+    heapAllocs++;
+}
+
+// every allocation after the seal goes to the heap, not just those //
+// that no longer fit, so the count shows each one                  //
+void* Arena_alloc(size_t size) {
+    if(sealed) {
+        Arena_noteHeapUse(size);
+        void* ret = malloc(size);
+        ErrorMsgIf(ret == NULL, VEXOS_NOMEMORY, "Cannot allocate %d bytes", (int) size);
+        return ret;
+    }
+    size = (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+    if(size > chunkFree) {
+        // the rest of the old chunk is abandoned //
+        size_t chunkSize = (size > ARENA_CHUNK_SIZE)? size: ARENA_CHUNK_SIZE;
+        chunk = malloc(chunkSize);
+        ErrorMsgIf(chunk == NULL, VEXOS_NOMEMORY, "Cannot allocate %d bytes", (int) chunkSize);
+        chunkFree = chunkSize;
+    }
+    void* ret  = chunk;
+    chunk     += size;
+    chunkFree -= size;
+    used      += size;
+    return ret;
+}
+
+void Arena_seal() {
+    sealed = true;
+}
+
+bool Arena_isSealed() {
+    return sealed;
+}
+
+size_t Arena_getUsed() {
+    return used;
+}
+
+size_t Arena_getFree() {
+    return chunkFree;
+}
+
+unsigned long Arena_getHeapAllocs() {
+    return heapAllocs;
+}
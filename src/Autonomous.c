@@ -78,7 +78,9 @@ static void updateWindow(Window* win, bool full) {
     while(node != NULL) {
         Command* cmd = node->data;
         if(full || programsChanged) {
-            PrintTextToGD(top, left + 2, Color_Black, "%.*s\n", width - 2, Command_getName(cmd));
+            char name[64];
+            Command_formatName(cmd, name, sizeof(name));
+            PrintTextToGD(top, left + 2, Color_Black, "%.*s\n", width - 2, name);
         }
         if(selected == cmd) selLine = top;
         top++;
@@ -125,7 +127,9 @@ static void drawLCDScreen(LCDScreen* screen, LCDButtonType pressed) {
         opts |= LCDTextOptions_LeftArrow;
         if(activeProgram->next != NULL) opts |= LCDTextOptions_RightArrow;
         Command* cmd = activeProgram->data;
-        LCD_setText(lcd, 2, opts, Command_getName(cmd));
+        char name[17];
+        Command_formatName(cmd, name, sizeof(name));
+        LCD_setText(lcd, 2, opts, "%s", name);
     }
 }
 
@@ -24,6 +24,7 @@
 #include "UserInterface.h"
 #include "Hardware.h"
 #include "Device.h"
+#include "InputLog.h"
 #include "Error.h"
 
 /********************************************************************
@@ -59,13 +60,22 @@ static PowerExpander* getMainPowerExpander() {
     return expand;
 }
 
+// voltages are inputs, logged in millivolts //
+static float getMainVoltage() {
+    return LogInput(InputChannel_MainBattery, (long) (GetMainBattery() * 1000)) / 1000.0;
+}
+
+static float getBackupVoltage() {
+    return LogInput(InputChannel_BackupBattery, (long) (GetBackupBattery() * 1000)) / 1000.0;
+}
+
 static void updateWindow(Window* win, bool full) {
     Rect innerRect = Window_getInnerRect(win);
     unsigned char left = innerRect.left;
     unsigned char top  = innerRect.top;
     float volts;
 
-    volts = GetMainBattery();
+    volts = getMainVoltage();
     PrintTextToGD(top, left, Color_Black, "Main:\n");
     PrintTextToGD(top++, left + 10, getBatteryColor(volts, false), "%1.2f V\n", volts);
     PowerExpander* expand = getMainPowerExpander();
@@ -75,7 +85,7 @@ static void updateWindow(Window* win, bool full) {
         PrintTextToGD(top,   left, Color_Black, "Expander:\n");
         PrintTextToGD(top++, left + 10, getBatteryColor(volts, false), "%1.2f V\n", volts);
     }
-    volts = GetBackupBattery();
+    volts = getBackupVoltage();
     PrintTextToGD(top,   left, Color_Black, "Backup:\n");
     PrintTextToGD(top++, left + 10, getBatteryColor(volts, true), "%1.2f V\n", volts);
 }
@@ -83,14 +93,17 @@ static void updateWindow(Window* win, bool full) {
 static void drawLCDScreen(LCDScreen* screen, LCDButtonType pressed) {
     LCD* lcd = LCDScreen_getLCD(screen);
     PowerExpander* expand = getMainPowerExpander();
+    // read in a fixed order, a replay expects the logged one //
+    float main = getMainVoltage();
     if(expand) {
+        float expander = PowerExpander_getBatteryVoltage(expand);
+        float backup   = getBackupVoltage();
         LCD_setText(lcd, 1, LCDTextOptions_Centered, "Main Expd Back");
-        LCD_setText(lcd, 2, LCDTextOptions_Centered, "%1.1fV %1.1fV %1.1fV", GetMainBattery(),
-                    PowerExpander_getBatteryVoltage(expand), GetBackupBattery());
+        LCD_setText(lcd, 2, LCDTextOptions_Centered, "%1.1fV %1.1fV %1.1fV", main, expander, backup);
     } else {
+        float backup = getBackupVoltage();
         LCD_setText(lcd, 1, LCDTextOptions_Centered, "Main Back");
-        LCD_setText(lcd, 2, LCDTextOptions_Centered, "%1.1fV %1.1fV", GetMainBattery(),
-                    GetBackupBattery());
+        LCD_setText(lcd, 2, LCDTextOptions_Centered, "%1.1fV %1.1fV", main, backup);
     }
 }
 
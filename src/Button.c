@@ -32,7 +32,9 @@
 
 #include "Button.h"
 #include "ButtonClass.h"
+#include "Command.h"
 #include "Scheduler.h"
+#include "Trace.h"
 #include "Error.h"
 
 /********************************************************************
@@ -107,6 +109,10 @@ static ButtonScheduler* getScheduler(Button* button, Command* cmd, ButtonSchedul
 
 static void callConstructorMethod(Button* button, void (method)(va_list), va_list argp) {
     if(!method) return;
+    if(!button->class->selfPtr) {
+        ((void (*)(Button*, va_list)) method)(button, argp);
+        return;
+    }
     Button* old = *(button->class->selfPtr);
     *(button->class->selfPtr) = button;
     method(argp);
@@ -115,6 +121,10 @@ static void callConstructorMethod(Button* button, void (method)(va_list), va_lis
 
 static void callVoidMethod(Button* button, void (method)()) {
     if(!method) return;
+    if(!button->class->selfPtr) {
+        method(button);
+        return;
+    }
     Button* old = *(button->class->selfPtr);
     *(button->class->selfPtr) = button;
     method();
@@ -123,6 +133,7 @@ static void callVoidMethod(Button* button, void (method)()) {
 
 static bool callBoolMethod(Button* button, bool (method)()) {
     if(!method) return true;
+    if(!button->class->selfPtr) return method(button);
     Button* old = *(button->class->selfPtr);
     *(button->class->selfPtr) = button;
     bool ret = method();
@@ -141,7 +152,12 @@ static void initializeButtonClass(ButtonClass* class) {
 
 void Button_executeScheduler(ButtonScheduler* sched) {
     // get the button //
-    bool state = Button_get(sched->button);
+    bool state   = Button_get(sched->button);
+    bool toggled = false;
+    if(state != sched->pressedLast) {
+        Trace(state? TraceEvent_ButtonPressed: TraceEvent_ButtonReleased,
+              sched->button, sched->button->objectId);
+    }
     // implement appropriate algorithm //
     switch(sched->type) {
         case ButtonSchedulerType_WhenPressed:
@@ -156,11 +172,16 @@ void Button_executeScheduler(ButtonScheduler* sched) {
             break;
         case ButtonSchedulerType_WhileHeld:
             if(state) {
-                sched->pressedLast = true;
-                Command_start(sched->command);
+                // start on the edge, afterwards only restart if it dropped out //
+                if(!sched->pressedLast || !Scheduler_isScheduled(sched->command)) {
+                    sched->pressedLast = true;
+                    sched->command->status |= CommandStatus_Held;
+                    Command_start(sched->command);
+                }
             } else {
                 if(sched->pressedLast) {
                     sched->pressedLast = false;
+                    sched->command->status &= ~CommandStatus_Held;
                     Command_cancel(sched->command);
                 }
             }
@@ -178,6 +199,7 @@ void Button_executeScheduler(ButtonScheduler* sched) {
         case ButtonSchedulerType_WhileToggled:
             if(state) {
                 if(!sched->pressedLast) {
+                    toggled = true;
                     sched->pressedLast = true;
                     sched->button->toggleState ^= true;
                     // if toggled on, clear the rest of the group //
@@ -199,9 +221,16 @@ void Button_executeScheduler(ButtonScheduler* sched) {
                 sched->pressedLast = false;
             }
             if(sched->button->toggleState) {
-                Command_start(sched->command);
-            } else if(Command_getStatus(sched->command) & CommandStatus_Running) {
-                Command_cancel(sched->command);
+                if(toggled || !Scheduler_isScheduled(sched->command)) {
+                    sched->command->status |= CommandStatus_Held;
+                    Command_start(sched->command);
+                }
+            } else {
+                // toggled off while preempted or blocked must not restart //
+                sched->command->status &= ~CommandStatus_Held;
+                if(Command_getStatus(sched->command) & CommandStatus_Running) {
+                    Command_cancel(sched->command);
+                }
             }
             break;
     }
@@ -212,6 +241,16 @@ Button* Button_getSchedulerButton(ButtonScheduler* sched) {
     return sched->button;
 }
 
+// the Command is no longer held once its binding is gone //
+void Button_deleteScheduler(ButtonScheduler* sched) {
+    if(sched == NULL) return;
+    if(sched->type == ButtonSchedulerType_WhileHeld ||
+       sched->type == ButtonSchedulerType_WhileToggled) {
+        sched->command->status &= ~CommandStatus_Held;
+    }
+    free(sched);
+}
+
 /********************************************************************
  * Protected API: Implicit Scope Methods                            *
  ********************************************************************/
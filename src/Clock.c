@@ -0,0 +1,81 @@
+//
+//  Clock.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#include "API.h"
+
+#include "Clock.h"
+#include "Error.h"
+
+/********************************************************************
+ * Private API                                                      *
+ ********************************************************************/
+
+#ifdef __arm__
+  // debug and trace registers of the Cortex-M3 core //
+  #define DEMCR         (*((volatile unsigned long*) 0xE000EDFC))
+  #define DWT_CTRL      (*((volatile unsigned long*) 0xE0001000))
+  #define DWT_CYCCNT    (*((volatile unsigned long*) 0xE0001004))
+  #define DEMCR_TRCENA          0x01000000
+  #define DWT_CTRL_CYCCNTENA    0x00000001
+#endif
+
+static unsigned long defaultTicks() {
+#ifdef __arm__
+    return DWT_CYCCNT;
+#else
+    return GetMsClock() * 1000;
+#endif
+}
+
+static ClockSource*  source        = &defaultTicks;
+static unsigned long ticksPerMicro = CLOCK_TICKS_PER_MICROSECOND;
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+void Clock_initialize() {
+#ifdef __arm__
+    // the cycle counter is off until trace is enabled //
+    DEMCR     |= DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL  |= DWT_CTRL_CYCCNTENA;
+#endif
+}
+
+// NULL restores the default source //
+void Clock_setSource(ClockSource* newSource, unsigned long newTicksPerMicro) {
+    ErrorIf(newSource != NULL && newTicksPerMicro == 0, VEXOS_ARGRANGE);
+    source        = (newSource)? newSource: &defaultTicks;
+    ticksPerMicro = (newSource)? newTicksPerMicro: CLOCK_TICKS_PER_MICROSECOND;
+}
+
+unsigned long Clock_getTicks() {
+    return source();
+}
+
+unsigned long Clock_getTicksPerMicro() {
+    return ticksPerMicro;
+}
+
+unsigned long Clock_ticksToMicros(unsigned long ticks) {
+    return ticks / ticksPerMicro;
+}
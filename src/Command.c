@@ -30,10 +30,17 @@
 //  present in this distribution.
 //
 
+#include <stddef.h>
+
 #include "Command.h"
 #include "CommandClass.h"
 #include "CommandGroup.h"
+#include "CommandProfile.h"
 #include "Scheduler.h"
+#include "Subsystem.h"
+#include "Clock.h"
+#include "Arena.h"
+#include "Trace.h"
 #include "Error.h"
 
 /********************************************************************
@@ -44,6 +51,10 @@ static unsigned int lastObjectId = 0;
 
 static void callConstructorMethod(Command* cmd, void (method)(va_list), va_list argp) {
     if(!method) return;
+    if(!cmd->class->selfPtr) {
+        ((void (*)(Command*, va_list)) method)(cmd, argp);
+        return;
+    }
     Command* old = *(cmd->class->selfPtr);
     *(cmd->class->selfPtr) = cmd;
     method(argp);
@@ -63,6 +74,10 @@ static void callGroupConstructorMethod(Command* cmd, void (method)(va_list), va_
 
 static void callVoidMethod(Command* cmd, void (method)()) {
     if(!method) return;
+    if(!cmd->class->selfPtr) {
+        method(cmd);
+        return;
+    }
     Command* old = *(cmd->class->selfPtr);
     *(cmd->class->selfPtr) = cmd;
     method();
@@ -71,6 +86,7 @@ static void callVoidMethod(Command* cmd, void (method)()) {
 
 static bool callBoolMethod(Command* cmd, bool (method)()) {
     if(!method) return true;
+    if(!cmd->class->selfPtr) return method(cmd);
     Command* old = *(cmd->class->selfPtr);
     *(cmd->class->selfPtr) = cmd;
     bool ret = method();
@@ -78,6 +94,254 @@ static bool callBoolMethod(Command* cmd, bool (method)()) {
     return ret;
 }
 
+static void profileVoidMethod(Command* cmd, CommandPhase phase, void (method)()) {
+    unsigned long start = Clock_getTicks();
+    callVoidMethod(cmd, method);
+    CommandProfile_record(cmd, phase, Clock_getTicks() - start);
+}
+
+static bool profileBoolMethod(Command* cmd, CommandPhase phase, bool (method)()) {
+    unsigned long start = Clock_getTicks();
+    bool ret = callBoolMethod(cmd, method);
+    CommandProfile_record(cmd, phase, Clock_getTicks() - start);
+    return ret;
+}
+
+// apply every timeout, cancel or wake time that has come //
+static void checkDeadlines(Command* cmd, unsigned long now) {
+    unsigned long elapsed = now - cmd->startTime;
+    if(cmd->timeout != COMMAND_TIME_NONE && elapsed >= cmd->timeout) {
+        cmd->status |= CommandStatus_TimedOut;
+        cmd->status &= ~CommandStatus_Sleeping;
+    }
+    if(cmd->cancelAfter != COMMAND_TIME_NONE && elapsed >= cmd->cancelAfter) {
+        Command_setCancelled(cmd);
+        cmd->status &= ~CommandStatus_Sleeping;
+    }
+    if(cmd->wakeTime != COMMAND_TIME_NONE && (long) (now - cmd->wakeTime) >= 0) {
+        cmd->status &= ~CommandStatus_Sleeping;
+    }
+}
+
+static void earliest(unsigned long* next, unsigned long time, unsigned long now) {
+    if((long) (time - now) <= 0) return;
+    if(*next == COMMAND_TIME_NONE || (long) (time - *next) < 0) *next = time;
+}
+
+// one wheel timer per Command, set for the earliest time still to come //
+static void armTimer(Command* cmd) {
+    if(cmd->startTime == COMMAND_TIME_NONE) return;
+    unsigned long now  = VexOS_getRunTimeMs();
+    unsigned long next = COMMAND_TIME_NONE;
+    checkDeadlines(cmd, now);
+    // awake again, the scheduler has to visit it //
+    if(!(cmd->status & CommandStatus_Sleeping)) Scheduler_wake(cmd);
+    if(cmd->timeout != COMMAND_TIME_NONE) {
+        earliest(&next, cmd->startTime + cmd->timeout, now);
+    }
+    if(cmd->cancelAfter != COMMAND_TIME_NONE) {
+        earliest(&next, cmd->startTime + cmd->cancelAfter, now);
+    }
+    if((cmd->status & CommandStatus_Sleeping) && cmd->wakeTime != COMMAND_TIME_NONE) {
+        earliest(&next, cmd->wakeTime, now);
+    }
+    if(next == COMMAND_TIME_NONE) {
+        TimerWheel_remove(&cmd->timer);
+    } else {
+        TimerWheel_add(&cmd->timer, next);
+    }
+}
+
+// a multi-rate Command sleeps until its next period comes round //
+static void sleepPeriod(Command* cmd) {
+    if(cmd->status & CommandStatus_Sleeping) return;
+    unsigned long now  = VexOS_getRunTimeMs();
+    unsigned long last = (cmd->wakeTime != COMMAND_TIME_NONE)? cmd->wakeTime: cmd->startTime;
+    unsigned long due  = last + cmd->period;
+    // drop missed periods rather than bursting //
+    if((long) (due - now) <= 0) due = now + cmd->period;
+    Command_sleepUntil(cmd, due);
+}
+
+static void timerExpired(WheelTimer* timer) {
+    armTimer(timer->data);
+}
+
+// length of the conversion at fmt, which starts with '%' //
+static size_t specLength(String fmt) {
+    return strspn(fmt + 1, "-+ #0123456789.hlLzjt") + 2;
+}
+
+// the value a conversion takes: 'i'nt, 'l'ong, 'q' long long, 'z' size_t, //
+// 't' ptrdiff_t, 'f'loat, 'D' long double, 's'tring, 'p'ointer, a '@'     //
+// Command whose name is formatted in place, or 0 if unsupported           //
+static char specType(String fmt, size_t length) {
+    switch(fmt[length - 1]) {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+        {
+            String l = memchr(fmt, 'l', length);
+            if(l != NULL) return (l[1] == 'l')? 'q': 'l';
+            if(memchr(fmt, 'j', length) != NULL) return 'q';
+            if(memchr(fmt, 'z', length) != NULL) return 'z';
+            if(memchr(fmt, 't', length) != NULL) return 't';
+            return 'i';
+        }
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+            return (memchr(fmt, 'L', length) != NULL)? 'D': 'f';
+        case 's': case 'p': case '@':
+            return fmt[length - 1];
+        default:
+            return 0;
+    }
+}
+
+// the number of values fmt takes, and if any is a string //
+static unsigned char countArgs(String fmt, bool* hasText) {
+    unsigned char count = 0;
+    *hasText = false;
+    for(; *fmt; fmt++) {
+        if(*fmt != '%') continue;
+        if(fmt[1] == '%') {
+            fmt++;
+            continue;
+        }
+        size_t length = specLength(fmt);
+        char type     = specType(fmt, length);
+        ErrorMsgIf(type == 0, VEXOS_ARGINVALID, "Unsupported Command name format: %s", fmt);
+        if(type == 's') *hasText = true;
+        count++;
+        fmt += length - 1;
+    }
+    return count;
+}
+
+static CommandArg takeArg(char type, va_list* argp) {
+    CommandArg arg;
+    switch(type) {
+        case 'i': arg.longValue     = va_arg(*argp, int);         break;
+        case 'l': arg.longValue     = va_arg(*argp, long);        break;
+        case 'q': arg.longLongValue = va_arg(*argp, long long);   break;
+        case 'z': arg.longLongValue = va_arg(*argp, size_t);      break;
+        case 't': arg.longLongValue = va_arg(*argp, ptrdiff_t);   break;
+        case 'f': arg.floatValue    = va_arg(*argp, double);      break;
+        case 'D': arg.floatValue    = va_arg(*argp, long double); break;
+        default:  arg.pointerValue  = va_arg(*argp, const void*); break;
+    }
+    return arg;
+}
+
+// copy the values for fmt into args, starting at first; nothing is formatted //
+static unsigned char captureArgs(Command* cmd, String fmt, va_list argp, unsigned char first) {
+    unsigned char count = first;
+    va_list args;
+    va_copy(args, argp);
+    for(; *fmt; fmt++) {
+        if(*fmt != '%') continue;
+        if(fmt[1] == '%') {
+            fmt++;
+            continue;
+        }
+        size_t length = specLength(fmt);
+        cmd->args[count++] = takeArg(specType(fmt, length), &args);
+        fmt += length - 1;
+    }
+    va_end(args);
+    return count;
+}
+
+static int formatArg(char* out, size_t left, String spec, char type, const CommandArg* arg) {
+    // a Command argument may name another, don't follow a loop forever //
+    static unsigned char depth = 0;
+    switch(type) {
+        case 'i': return snprintf(out, left, spec, (int) arg->longValue);
+        case 'l': return snprintf(out, left, spec, arg->longValue);
+        case 'q': return snprintf(out, left, spec, arg->longLongValue);
+        case 'z': return snprintf(out, left, spec, (size_t) arg->longLongValue);
+        case 't': return snprintf(out, left, spec, (ptrdiff_t) arg->longLongValue);
+        case 'f': return snprintf(out, left, spec, arg->floatValue);
+        case 'D': return snprintf(out, left, spec, (long double) arg->floatValue);
+        case '@':
+        {
+            if(arg->pointerValue == NULL || depth >= 4) return snprintf(out, left, "...");
+            depth++;
+            int n = Command_formatName((Command*) arg->pointerValue, out, left);
+            depth--;
+            return n;
+        }
+        default:  return snprintf(out, left, spec, arg->pointerValue);
+    }
+}
+
+// one conversion at a time, never writes more than size; values come //
+// from args, or from argp when args is NULL                          //
+static size_t formatArgs(char* buffer, size_t size, String fmt, const CommandArg* args,
+                         va_list* argp) {
+    size_t used = 0;
+    char spec[16];
+    while(*fmt && used + 1 < size) {
+        if(*fmt != '%') {
+            buffer[used++] = *fmt++;
+            continue;
+        }
+        if(fmt[1] == '%') {
+            buffer[used++] = '%';
+            fmt += 2;
+            continue;
+        }
+        size_t length = specLength(fmt);
+        char type     = specType(fmt, length);
+        if(type == 0 || length >= sizeof(spec)) break;
+        memcpy(spec, fmt, length);
+        spec[length] = '\0';
+        CommandArg arg = (args)? *args++: takeArg(type, argp);
+        size_t left    = size - used;
+        int n = formatArg(buffer + used, left, spec, type, &arg);
+        if(n > 0) used += ((size_t) n < left)? (size_t) n: left - 1;
+        fmt += length;
+    }
+    buffer[used] = '\0';
+    return used;
+}
+
+// a name with strings, which may not outlive the call, or more values //
+// than args can keep is formatted now. The text is kept in the arena, //
+// once it is sealed a Command without room uses its class name        //
+static void setNameText(Command* cmd, String prefix, String fmt, va_list argp) {
+    char text[COMMAND_NAME_MAX];
+    size_t used = 0;
+    if(prefix) {
+        int n = snprintf(text, sizeof(text), "%s(", prefix);
+        used  = (n < 0)? 0: ((size_t) n < sizeof(text) - 2)? (size_t) n: sizeof(text) - 2;
+    }
+    // leave room for the closing paren //
+    va_list args;
+    va_copy(args, argp);
+    used += formatArgs(text + used, sizeof(text) - used - ((prefix)? 1: 0), fmt, NULL, &args);
+    va_end(args);
+    if(prefix) {
+        text[used++] = ')';
+        text[used]   = '\0';
+    }
+    
+    cmd->nameFmt      = NULL;
+    cmd->argsFmt      = NULL;
+    cmd->nameArgCount = 0;
+    cmd->argCount     = 0;
+    if(used + 1 > cmd->nameTextSize) {
+        if(Arena_isSealed()) return;
+        cmd->nameText     = Arena_alloc(used + 1);
+        cmd->nameTextSize = used + 1;
+    }
+    memcpy(cmd->nameText, text, used + 1);
+    
+    // the text is the whole name now //
+    static const char textFmt[] = "%s";
+    cmd->nameFmt              = textFmt;
+    cmd->args[0].pointerValue = cmd->nameText;
+    cmd->nameArgCount         = 1;
+    cmd->argCount             = 1;
+}
+
 static void initializeCommandClass(CommandClass* class) {
     // if a group subclass, clone things from the prototype CommandGroup //
     if(class->groupConstructor) {
@@ -94,7 +358,7 @@ static void initializeCommandClass(CommandClass* class) {
     }
     // normal initialization //
     class->initialized = true;
-    *(class->selfPtr)  = NULL;
+    if(class->selfPtr) *(class->selfPtr) = NULL;
     class->lastInstanceId = 0;
 }
 
@@ -111,34 +375,59 @@ bool Command_run(Command* cmd) {
     }
     if(!(cmd->status & CommandStatus_Initialized)) {
         cmd->status |= CommandStatus_Initialized;
-        cmd->startTime = VexOS_getRunTime();
+        cmd->startTime = VexOS_getRunTimeMs();
+        cmd->wakeTime  = COMMAND_TIME_NONE;
+        armTimer(cmd);
+        Trace(TraceEvent_CommandInitialize, cmd, cmd->objectId);
         Debug("Initialize:  %s", Command_getName(cmd));
-        callVoidMethod(cmd, cmd->class->initialize);
+        if(CommandProfileEnabled) {
+            profileVoidMethod(cmd, CommandPhase_Initialize, cmd->class->initialize);
+        } else {
+            callVoidMethod(cmd, cmd->class->initialize);
+        }
+    }
+    // nothing to do until the timer wheel wakes it //
+    if(cmd->status & CommandStatus_Sleeping) {
+        return true;
     }
     Debug("Execute:     %s", Command_getName(cmd));
-    callVoidMethod(cmd, cmd->class->execute);
-    return !callBoolMethod(cmd, cmd->class->isFinished);
+    bool finished;
+    if(CommandProfileEnabled) {
+        profileVoidMethod(cmd, CommandPhase_Execute, cmd->class->execute);
+        finished = profileBoolMethod(cmd, CommandPhase_IsFinished, cmd->class->isFinished);
+    } else {
+        callVoidMethod(cmd, cmd->class->execute);
+        finished = callBoolMethod(cmd, cmd->class->isFinished);
+    }
+    if(!finished && cmd->period != COMMAND_TIME_NONE) sleepPeriod(cmd);
+    return !finished;
 }
 
 void Command_removed(Command* cmd) {
     if(cmd->status & CommandStatus_Initialized) {
         if(cmd->status & CommandStatus_Cancelled) {
+            Trace(TraceEvent_CommandInterrupted, cmd, cmd->objectId);
             Debug("Interrupted: %s", Command_getName(cmd));
             callVoidMethod(cmd, cmd->class->interrupted);
         } else {
+            Trace(TraceEvent_CommandEnd, cmd, cmd->objectId);
             Debug("End:         %s", Command_getName(cmd));
             callVoidMethod(cmd, cmd->class->end);
         }
     }
+    TimerWheel_remove(&cmd->timer);
     cmd->status &= ~(CommandStatus_Initialized
                      | CommandStatus_Cancelled
                      | CommandStatus_Running
+                     | CommandStatus_TimedOut
+                     | CommandStatus_Sleeping
                      );
 }
 
 void Command_setCancelled(Command* cmd) {
     if(cmd->status & CommandStatus_Running) {
         cmd->status |= CommandStatus_Cancelled;
+        Scheduler_wake(cmd);
     }
 }
 
@@ -148,10 +437,34 @@ void Command_setParent(Command* cmd, Command* group) {
     cmd->parent = group;
 }
 
-void Command_startRunning(Command* cmd) {
-    cmd->status |= CommandStatus_Running;
-    cmd->startTime = NAN;
-    
+void Command_startRunning(Command* cmd, unsigned long cancelAfter) {
+    cmd->status     |= CommandStatus_Running;
+    cmd->startTime   = COMMAND_TIME_NONE;
+    cmd->cancelAfter = cancelAfter;
+}
+
+// the Command and its fields are one block from the arena //
+Command* Command_allocate(CommandClass* class) {
+    if(!class->initialized) {
+        initializeCommandClass(class);
+    }
+    size_t size  = (sizeof(Command) + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+    Command* cmd = Arena_alloc(size + class->fieldSize);
+    cmd->class        = class;
+    cmd->fields       = (class->fieldSize > 0)? (struct Fields*) ((char*) cmd + size): NULL;
+    cmd->nameText     = NULL;
+    cmd->nameTextSize = 0;
+    return cmd;
+}
+
+unsigned long Command_msSinceInitialized(Command* cmd) {
+    if(cmd->startTime == COMMAND_TIME_NONE) return COMMAND_TIME_NONE;
+    return VexOS_getRunTimeMs() - cmd->startTime;
+}
+
+unsigned long Command_secondsToMs(float seconds) {
+    if(isnan(seconds) || seconds < 0) return COMMAND_TIME_NONE;
+    return (unsigned long) (seconds * 1000 + 0.5);
 }
 
 /********************************************************************
@@ -161,21 +474,33 @@ void Command_startRunning(Command* cmd) {
 void Command_setvName(Command* cmd, String fmt, va_list argp) {
     ErrorIf(fmt == NULL, VEXOS_ARGNULL);
     
-    char* old = (char*) cmd->name;
-    vasprintf((char**) &cmd->name, fmt, argp);
-    if(old) free(old);
+    // a new name drops any arguments set before it //
+    bool hasText;
+    if(countArgs(fmt, &hasText) > COMMAND_MAX_ARGS || hasText) {
+        setNameText(cmd, NULL, fmt, argp);
+        return;
+    }
+    cmd->nameFmt      = fmt;
+    cmd->argsFmt      = NULL;
+    cmd->nameArgCount = captureArgs(cmd, fmt, argp, 0);
+    cmd->argCount     = cmd->nameArgCount;
 }
 
 void Command_setvArgs(Command* cmd, String fmt, va_list argp) {
     ErrorIf(fmt == NULL, VEXOS_ARGNULL);
     
-    char* old = (char*) Command_getName(cmd);
-    char* xfmt;
-    asprintf(&xfmt, "%s(%s)", old, fmt);
-    // print new name //
-    vasprintf((char**) &cmd->name, xfmt, argp);
-    free(xfmt);
-    free(old);
+    bool hasText;
+    if(cmd->nameArgCount + countArgs(fmt, &hasText) > COMMAND_MAX_ARGS || hasText) {
+        // new arguments replace any set before them //
+        char name[COMMAND_NAME_MAX];
+        cmd->argsFmt  = NULL;
+        cmd->argCount = cmd->nameArgCount;
+        Command_formatName(cmd, name, sizeof(name));
+        setNameText(cmd, name, fmt, argp);
+        return;
+    }
+    cmd->argsFmt  = fmt;
+    cmd->argCount = captureArgs(cmd, fmt, argp, cmd->nameArgCount);
 }
 
 void Command_require(Command* cmd, Subsystem* sys) {
@@ -184,19 +509,29 @@ void Command_require(Command* cmd, Subsystem* sys) {
     ErrorIf(sys == NULL, VEXOS_ARGNULL);
     ErrorMsgIf(!Subsystem_isInitialized(sys), VEXOS_OPINVALID, "Subsystem is not initialized: %s",
                Subsystem_getName(sys));
-                
-    if(!Command_doesRequireSubsystem(cmd, sys)) {
-        List_insertLast(&cmd->requiresList, List_newNode(sys));
-    }
+    
+    cmd->requireMask |= sys->requireBit;
 }
 
 void Command_setTimeout(Command* cmd, float timeoutSec) {
-    cmd->timeout = timeoutSec;
+    cmd->timeout = Command_secondsToMs(timeoutSec);
+    cmd->status &= ~CommandStatus_TimedOut;
+    if(cmd->status & CommandStatus_Initialized) armTimer(cmd);
 }
 
+// set by the timer wheel, nothing is compared here //
 bool Command_isTimedOut(Command* cmd) {
-    return !isnan(cmd->timeout) &&
-        (Command_timeSinceInitialized(cmd) >= cmd->timeout);
+    return (cmd->status & CommandStatus_TimedOut) != 0;
+}
+
+// skip execute and isFinished until timeMs, a timeout or a cancel; //
+// COMMAND_TIME_NONE sleeps until one of the latter two             //
+void Command_sleepUntil(Command* cmd, unsigned long timeMs) {
+    if(cmd->status & (CommandStatus_TimedOut | CommandStatus_Cancelled)) return;
+    if(timeMs != COMMAND_TIME_NONE && (long) (timeMs - VexOS_getRunTimeMs()) <= 0) return;
+    cmd->status  |= CommandStatus_Sleeping;
+    cmd->wakeTime = timeMs;
+    armTimer(cmd);
 }
 
 void Command_setInterruptible(Command* cmd, bool inter) {
@@ -220,21 +555,36 @@ Command* Command_new(CommandClass* class, ...) {
     if(!class->initialized) {
         initializeCommandClass(class);
     }
-    // create the Command //
-    Command* cmd = malloc(sizeof(Command));
-    cmd->class           = class;
+    // reuse a deleted Command if there is one //
+    Command* cmd = class->freeList;
+    if(cmd != NULL) {
+        class->freeList = cmd->parent;
+    } else {
+        cmd = Command_allocate(class);
+    }
     cmd->objectId        = ++lastObjectId;
     cmd->instanceId      = ++class->lastInstanceId;
-    cmd->name            = NULL;
+    cmd->nameFmt         = NULL;
+    cmd->argsFmt         = NULL;
+    cmd->nameArgCount    = 0;
+    cmd->argCount        = 0;
     cmd->parent          = NULL;
     cmd->status          = 0;
-    cmd->startTime       = NAN;
-    cmd->timeout         = NAN;
+    cmd->startTime       = COMMAND_TIME_NONE;
+    cmd->timeout         = COMMAND_TIME_NONE;
+    cmd->cancelAfter     = COMMAND_TIME_NONE;
+    cmd->wakeTime        = COMMAND_TIME_NONE;
+    cmd->period          = COMMAND_TIME_NONE;
+    cmd->timer           = (WheelTimer) { .handler = &timerExpired, .data = cmd };
     cmd->interruptible   = true;
     cmd->runWhenDisabled = false;
-    memset(&cmd->requiresList, 0, sizeof(List));
-    // build the fields //
-    cmd->fields = (class->fieldSize > 0)? malloc(class->fieldSize): NULL;
+    cmd->priority        = CommandPriority_Normal;
+    cmd->requireMask     = 0;
+    cmd->runNode         = (ListNode) { .data = cmd };
+    cmd->queueNode       = (ListNode) { .data = cmd };
+    cmd->profile         = NULL;
+    // profiles come from the arena, while it is still open //
+    if(CommandProfileEnabled) CommandProfile_add(cmd);
     // call the constructor //
     va_list argp;
     va_start(argp, class);
@@ -249,10 +599,14 @@ Command* Command_new(CommandClass* class, ...) {
 
 Command* Command_delete(Command* cmd) {
     if(!cmd) return NULL;
+    ErrorMsgIf(cmd->runNode.list || cmd->queueNode.list, VEXOS_OPINVALID,
+               "Cannot delete a scheduled Command: %s", Command_getName(cmd));
     callVoidMethod(cmd, cmd->class->destructor);
-    if(cmd->name) free((void*) cmd->name);
-    if(cmd->fields) free(cmd->fields);
-    free(cmd);
+    CommandProfile_remove(cmd);
+    // keep the memory for the next Command of the class, linked by parent //
+    CommandClass* class = (CommandClass*) cmd->class;
+    cmd->parent     = class->freeList;
+    class->freeList = cmd;
     return NULL;
 }
 
@@ -273,13 +627,38 @@ void Command_cancel(Command* cmd) {
     Command_setCancelled(cmd);
 }
 
+// the returned name is only good until a few more names are asked for //
 String Command_getName(Command* cmd) {
+    static char names[4][COMMAND_NAME_MAX];
+    static unsigned char next = 0;
     ErrorIf(cmd == NULL, VEXOS_ARGNULL);
 
-    if(!cmd->name) {
-        asprintf((char**) &cmd->name, "%s[%d]", cmd->class->name, cmd->instanceId);
+    char* buffer = names[next];
+    next = (next + 1) % 4;
+    Command_formatName(cmd, buffer, COMMAND_NAME_MAX);
+    return buffer;
+}
+
+int Command_formatName(Command* cmd, char* buffer, size_t size) {
+    ErrorIf(cmd == NULL, VEXOS_ARGNULL);
+    ErrorIf(buffer == NULL, VEXOS_ARGNULL);
+    if(size == 0) return 0;
+
+    size_t used;
+    if(cmd->nameFmt) {
+        used = formatArgs(buffer, size, cmd->nameFmt, cmd->args, NULL);
+    } else {
+        int n = snprintf(buffer, size, "%s[%u]", cmd->class->name, cmd->instanceId);
+        used = (n < 0)? 0: ((size_t) n < size)? (size_t) n: size - 1;
+    }
+    if(cmd->argsFmt && used + 2 < size) {
+        buffer[used++] = '(';
+        used += formatArgs(buffer + used, size - used - 1, cmd->argsFmt,
+                           cmd->args + cmd->nameArgCount, NULL);
+        buffer[used++] = ')';
+        buffer[used]   = '\0';
     }
-    return cmd->name;
+    return (int) used;
 }
 
 CommandClass* Command_getClass(Command* cmd) {
@@ -322,22 +701,37 @@ void Command_setRunWhenDisabled(Command* cmd, bool run) {
     cmd->runWhenDisabled = run;
 }
 
+CommandPriority Command_getPriority(Command* cmd) {
+    ErrorIf(cmd == NULL, VEXOS_ARGNULL);
+    
+    return cmd->priority;
+}
+
+void Command_setPriority(Command* cmd, CommandPriority priority) {
+    ErrorIf(cmd == NULL, VEXOS_ARGNULL);
+    ErrorIf(priority < CommandPriority_Low || priority > CommandPriority_Critical, VEXOS_ARGRANGE);
+    
+    Scheduler_setPriority(cmd, priority);
+}
+
+// 0 runs every loop, otherwise execute and isFinished run once a period //
+void Command_setPeriod(Command* cmd, float seconds) {
+    ErrorIf(cmd == NULL, VEXOS_ARGNULL);
+    
+    unsigned long period = Command_secondsToMs(seconds);
+    cmd->period = (period == 0)? COMMAND_TIME_NONE: period;
+}
+
 bool Command_doesRequireSubsystem(Command* cmd, Subsystem* sys) {
     ErrorIf(cmd == NULL, VEXOS_ARGNULL);
     ErrorIf(sys == NULL, VEXOS_ARGNULL);
     
-    // loop through subsystems //
-    ListNode* node = cmd->requiresList.firstNode;
-    while(node != NULL) {
-        if(((const Subsystem*) node->data) == sys) return true;
-        node = node->next;
-    }
-    return false;
+    return (cmd->requireMask & sys->requireBit) != 0;
 }
 
 float Command_timeSinceInitialized(Command* cmd) {
     ErrorIf(cmd == NULL, VEXOS_ARGNULL);
     
-    if(isnan(cmd->startTime)) return -1.0;
-    return (VexOS_getRunTime() - cmd->startTime);
+    if(cmd->startTime == COMMAND_TIME_NONE) return -1.0;
+    return (VexOS_getRunTimeMs() - cmd->startTime) / 1000.0;
 }
@@ -19,6 +19,7 @@
 //  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
 //
 
+#include "Command.h"
 #include "CommandClass.h"
 #include "Error.h"
 
@@ -37,3 +38,14 @@ bool CommandClass_isInitialized(CommandClass* class) {
 
     return class->initialized;
 }
+
+void CommandClass_reserve(CommandClass* class, unsigned int count) {
+    ErrorIf(class == NULL, VEXOS_ARGNULL);
+    
+    // preallocate Commands onto the free list //
+    while(count-- > 0) {
+        Command* cmd    = Command_allocate(class);
+        cmd->parent     = class->freeList;
+        class->freeList = cmd;
+    }
+}
@@ -22,6 +22,8 @@
 #include "Command.h"
 #include "CommandClass.h"
 #include "CommandGroup.h"
+#include "Scheduler.h"
+#include "Arena.h"
 #include "Error.h"
 
 /********************************************************************
@@ -29,36 +31,25 @@
  ********************************************************************/
 
 DefineCommandClass(CommandGroup, {
-    String    name;
-    List      commands;
-    List      children;
-    ListNode* currentNode;
-    bool      done;
+    String         name;
+    GroupStep*     steps;
+    unsigned short stepCount;
+    unsigned short stepCapacity;
+    // sequential step running, stepCount when done //
+    unsigned short current;
+    // lowest step that may be a running child //
+    unsigned short firstChild;
+    unsigned short childCount;
+    bool           sealed;
+    bool           started;
 });
 
 /********************************************************************
  * Private API                                                      *
  ********************************************************************/
 
-// static pool of nodes //
-static List nodeCache;
-
-static ListNode* getNode(void* data) {
-    ListNode* node = nodeCache.firstNode;
-    if(node != NULL) {
-        List_remove(node);
-        node->data = data;
-    } else {
-        node = List_newNode(data);
-    }
-    return node;
-}
-
-static ListNode* freeNode(ListNode* node) {
-    ListNode* next = List_remove(node);
-    List_insertLast(&nodeCache, node);
-    return next;
-}
+// groups not yet sealed, all are sealed before the arena is //
+static List unsealedList;
 
 static void addEntryNode(Command* group, Command* cmd, GroupEntryState state, float timeoutSec) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
@@ -67,53 +58,149 @@ static void addEntryNode(Command* group, Command* cmd, GroupEntryState state, fl
     ErrorMsgIf(group->status & CommandStatus_Locked, VEXOS_OPINVALID,
                "Cannot add Command, CommandGroup is locked: %s", Command_getName(cmd));
     
+    Fields* fields = group->fields;
+    ErrorMsgIf(fields->sealed, VEXOS_OPINVALID,
+               "Cannot add Command, CommandGroup has already run: %s", Command_getName(group));
+    // grow the build array, it is compacted when sealed //
+    if(fields->stepCount == fields->stepCapacity) {
+        fields->stepCapacity = (fields->stepCapacity)? fields->stepCapacity * 2: 4;
+        // a group built during a match grows on the heap //
+        if(Arena_isSealed()) Arena_noteHeapUse(fields->stepCapacity * sizeof(GroupStep));
+        fields->steps = realloc(fields->steps, fields->stepCapacity * sizeof(GroupStep));
+        ErrorIf(fields->steps == NULL, VEXOS_NOMEMORY);
+    }
     // process the entry //
-    GroupEntry* entry = (GroupEntry*) malloc(sizeof(GroupEntry));
-    entry->command = cmd;
-    entry->state   = state;
-    entry->timeout = timeoutSec;
-    // add to command list //
-    List_insertLast(&group->fields->commands, getNode(entry));
+    GroupStep* step = &fields->steps[fields->stepCount++];
+    step->command   = cmd;
+    step->state     = state;
+    step->timeout   = Command_secondsToMs(timeoutSec);
+    step->running   = false;
     cmd->parent = group;
     // add requirements to group //
-    ListNode* node = cmd->requiresList.firstNode;
-    while(node != NULL) {
-        Command_require(group, (Subsystem*) node->data);
-        node = node->next;
+    group->requireMask |= cmd->requireMask;
+}
+
+// move the steps into one block and precompute the parallel spans //
+static void seal(Fields* fields) {
+    GroupStep* steps = NULL;
+    if(fields->stepCount > 0) {
+        steps = Arena_alloc(fields->stepCount * sizeof(GroupStep));
+        memcpy(steps, fields->steps, fields->stepCount * sizeof(GroupStep));
+    }
+    free(fields->steps);
+    fields->steps        = steps;
+    fields->stepCapacity = fields->stepCount;
+    
+    // walk backwards, next is the step that ends the parallel span //
+    unsigned short next = fields->stepCount;
+    int i;
+    for(i = fields->stepCount - 1; i >= 0; i--) {
+        GroupStep* step = &steps[i];
+        step->requireMask = step->command->requireMask;
+        switch(step->state) {
+            case GroupEntryState_BranchChild:
+                step->next = next;
+                break;
+            case GroupEntryState_RaceMember:
+                // adjacent members are one race //
+                step->next = (next == i + 1 && next < fields->stepCount &&
+                              steps[next].state == GroupEntryState_RaceMember)?
+                              steps[next].next: i + 1;
+                next = i;
+                break;
+            default:
+                step->next = i + 1;
+                next = i;
+                break;
+        }
     }
+    fields->sealed = true;
 }
 
-static bool isEntryTimedOut(GroupEntry* entry) {
-    if(isnan(entry->timeout)) {
-        return false;
-    } else {
-        float time = Command_timeSinceInitialized(entry->command);
-        return (time == -1.0)? false : (time >= entry->timeout);
+static void removeChild(Fields* fields, GroupStep* step) {
+    Command_removed(step->command);
+    step->running = false;
+    fields->childCount--;
+}
+
+// cancel active children with the same requirements as specifed step //
+static void cancelConflicts(GroupStep* step) {
+    Fields* fields = self->fields;
+    if(fields->childCount == 0 || step->requireMask == 0) return;
+    unsigned short i;
+    for(i = fields->firstChild; i < fields->current; i++) {
+        GroupStep* child = &fields->steps[i];
+        // remove child if it requires any subsystem the step does //
+        if(child->running && (child->requireMask & step->requireMask)) {
+            Command_setCancelled(child->command);
+            removeChild(fields, child);
+        }
     }
 }
 
-// cancel active children with the same requirements as specifed command //
-static void cancelConflicts(Command* command) {
-    ListNode* node = self->fields->children.firstNode;
-    ListNode* temp = NULL;
-    while(node != NULL) {
-        temp = NULL;
-        GroupEntry* entry = (GroupEntry*) node->data;
-        // get command requirements //
-        ListNode* reqNode = command->requiresList.firstNode;
-        while(reqNode != NULL) {
-            Subsystem* sys = reqNode->data;
-            // remove child if it requires same subsystem as command //
-            if(Command_doesRequireSubsystem(entry->command, sys)) {
-                Command_setCancelled(entry->command);
-                Command_removed(entry->command);
-                temp = freeNode(node);
-                break;
-            }
-            reqNode = reqNode->next;
+static void cancelChildren(Fields* fields) {
+    unsigned short i;
+    for(i = fields->firstChild; fields->childCount > 0 && i < fields->current; i++) {
+        GroupStep* child = &fields->steps[i];
+        if(child->running) {
+            Command_setCancelled(child->command);
+            removeChild(fields, child);
+        }
+    }
+}
+
+// run every member, the first to finish ends the race and cancels the rest //
+static bool runRace(Fields* fields, GroupStep* first) {
+    GroupStep* last = &fields->steps[first->next];
+    GroupStep* step;
+    bool racing = true;
+    for(step = first; racing && step < last; step++) {
+        if(!Command_run(step->command)) {
+            Command_removed(step->command);
+            step->running = false;
+            racing = false;
+        }
+    }
+    if(racing) return true;
+    for(step = first; step < last; step++) {
+        if(step->running) {
+            Command_setCancelled(step->command);
+            Command_removed(step->command);
+            step->running = false;
+        }
+    }
+    return false;
+}
+
+// start the parallel span at the current step and the sequential step ending it //
+static void enterStep(Fields* fields) {
+    if(fields->current >= fields->stepCount) return;
+    GroupStep* step = &fields->steps[fields->current];
+    if(step->state == GroupEntryState_BranchChild) {
+        unsigned short end = step->next;
+        unsigned short i;
+        for(i = fields->current; i < end; i++) {
+            GroupStep* child = &fields->steps[i];
+            fields->current = i + 1;
+            cancelConflicts(child);
+            Command_startRunning(child->command, child->timeout);
+            child->running = true;
+            if(fields->childCount++ == 0) fields->firstChild = i;
         }
-        node = (temp)? temp: node->next;
+        if(end >= fields->stepCount) return;
+        step = &fields->steps[end];
     }
+    if(step->state == GroupEntryState_RaceMember) {
+        GroupStep* last = &fields->steps[step->next];
+        for(; step < last; step++) {
+            Command_startRunning(step->command, step->timeout);
+            cancelConflicts(step);
+            step->running = true;
+        }
+        return;
+    }
+    Command_startRunning(step->command, step->timeout);
+    cancelConflicts(step);
 }
 
 /********************************************************************
@@ -129,109 +216,86 @@ static void constructor(va_list argp) {
         // subclass of CommandGroup, don't want redundant name argument //
         self->fields->name = self->class->name;
     }
-    memset(&self->fields->commands, 0, sizeof(List));
-    memset(&self->fields->children, 0, sizeof(List));
-    self->fields->currentNode = NULL;
-    self->fields->done        = false;
+    self->fields->steps        = NULL;
+    self->fields->stepCount    = 0;
+    self->fields->stepCapacity = 0;
+    self->fields->current      = 0;
+    self->fields->firstChild   = 0;
+    self->fields->childCount   = 0;
+    self->fields->sealed       = false;
+    self->fields->started      = false;
+    // a reused group may still be waiting to be sealed //
+    if(!Arena_isSealed() && !List_findNode(&unsealedList, self)) {
+        List_insertLast(&unsealedList, List_newNode(self));
+    }
 }
 
 static void initialize() {
-    self->fields->currentNode = NULL;
-    self->fields->done        = false;
+    if(!self->fields->sealed) seal(self->fields);
+    self->fields->current    = 0;
+    self->fields->firstChild = 0;
+    self->fields->started = false;
 }
 
 static void execute() {
-    GroupEntry* entry = NULL;
-    Command*    cmd   = NULL;
-    
-    bool firstRun = false;
-    if(!self->fields->done && self->fields->currentNode == NULL) {
-        firstRun = true;
-        self->fields->currentNode = self->fields->commands.firstNode;
+    Fields* fields = self->fields;
+    if(!fields->started) {
+        fields->started = true;
+        enterStep(fields);
     }
     
-    while(self->fields->currentNode != NULL) {
-        if(cmd != NULL) {
-            if(isEntryTimedOut(entry)) {
-                Command_setCancelled(cmd);
-            }
-            if(Command_run(cmd)) {
-                break;
-            } else {
-                Command_removed(cmd);
-                self->fields->currentNode = self->fields->currentNode->next;
-                if(!self->fields->currentNode) self->fields->done = true;
-                firstRun = true;
-                cmd      = NULL;
-                continue;
-            }
-        }
-        
-        entry = (GroupEntry*) self->fields->currentNode->data;
-        cmd   = NULL;
-        switch (entry->state) {
-            case GroupEntryState_InSequence:
-                cmd = entry->command;
-                if(firstRun) {
-                    Command_startRunning(cmd);
-                    cancelConflicts(cmd);
-                }
-                firstRun = false;
-                break;
-            case GroupEntryState_BranchPeer:
-                // this seems to never be run //
-                self->fields->currentNode = self->fields->currentNode->next;
-                if(!self->fields->currentNode) self->fields->done = true;
-                Command_start(entry->command);
-                break;
-            case GroupEntryState_BranchChild:
-                self->fields->currentNode = self->fields->currentNode->next;
-                if(!self->fields->currentNode) self->fields->done = true;
-                cancelConflicts(entry->command);
-                Command_startRunning(entry->command);
-                // put a copy of the entry on the child list //
-                List_insertLast(&self->fields->children, getNode(entry));
-                break;
+    // run the sequential step, moving on as each one finishes //
+    while(fields->current < fields->stepCount) {
+        CountVisit();
+        GroupStep* step = &fields->steps[fields->current];
+        if(step->state == GroupEntryState_RaceMember) {
+            if(runRace(fields, step)) break;
+        } else {
+            if(Command_run(step->command)) break;
+            Command_removed(step->command);
+            // a deadline ends the children running alongside it //
+            if(step->state == GroupEntryState_Deadline) cancelChildren(fields);
         }
+        fields->current = step->next;
+        enterStep(fields);
     }
     
-    // run children on the child list //
-    ListNode* node = self->fields->children.firstNode;
-    while(node != NULL) {
-        entry = (GroupEntry*) node->data;
-        if(isEntryTimedOut(entry)) {
-            Command_setCancelled(entry->command);
-        }
-        if(!Command_run(entry->command)) {
-            Command_removed(entry->command);
-            node = freeNode(node);
+    // run the children, they all come before the current step //
+    unsigned short i;
+    for(i = fields->firstChild; fields->childCount > 0 && i < fields->current; i++) {
+        CountVisit();
+        GroupStep* child = &fields->steps[i];
+        if(!child->running) {
+            if(i == fields->firstChild) fields->firstChild++;
             continue;
         }
-        node = node->next;
+        if(!Command_run(child->command)) {
+            removeChild(fields, child);
+        }
     }
 }
 
 static void end() {
-    // cancel the current command //
-    Command* cmd = NULL;
-    if(self->fields->currentNode != NULL) {
-        cmd = ((GroupEntry*) self->fields->currentNode->data)->command;
-        Command_setCancelled(cmd);
-        Command_removed(cmd);
+    Fields* fields = self->fields;
+    // cancel the current command, or every member of the current race //
+    if(fields->started && fields->current < fields->stepCount) {
+        GroupStep* step = &fields->steps[fields->current];
+        GroupStep* last = &fields->steps[step->next];
+        for(; step < last; step++) {
+            if(step->state == GroupEntryState_RaceMember && !step->running) continue;
+            Command_setCancelled(step->command);
+            Command_removed(step->command);
+            step->running = false;
+        }
     }
     
     // cancel and remove all children //
-    ListNode* node = self->fields->children.firstNode;
-    while(node != NULL) {
-        cmd = ((GroupEntry*) node->data)->command;
-        Command_setCancelled(cmd);
-        Command_removed(cmd);
-        node = freeNode(node);
-    }
+    cancelChildren(fields);
 }
 
 static bool isFinished() {
-    return (self->fields->done) && (self->fields->children.nodeCount == 0);
+    return (self->fields->started) && (self->fields->current >= self->fields->stepCount) &&
+           (self->fields->childCount == 0);
 }
 
 static void interrupted() {
@@ -251,30 +315,57 @@ bool CommandGroup_isInterruptible(Command* group) {
     // is the group interruptible (not sure how this is set if we don't allow subclassing) //
     if(!group->interruptible) return false;
     
-    // see if the current node is interruptible //
-    Command* cmd;
-    if(group->fields->currentNode != NULL) {
-        cmd = ((GroupEntry*) group->fields->currentNode->data)->command;
-        if(!cmd->interruptible) return false;
+    // see if the current step, or any racing with it, is interruptible //
+    Fields* fields = group->fields;
+    Command* cmd = CommandGroup_getCurrentCommand(group);
+    if(cmd != NULL) {
+        unsigned short i;
+        for(i = fields->current; i < fields->steps[fields->current].next; i++) {
+            if(!fields->steps[i].command->interruptible) return false;
+        }
     }
     
     // check for an uninterruptible child //
-    ListNode* node = group->fields->children.firstNode;
-    while(node != NULL) {
-        cmd = ((GroupEntry*) node->data)->command;
-        if(!cmd->interruptible) return false;
-        node = node->next;
+    unsigned short i;
+    for(i = fields->firstChild; fields->childCount > 0 && i < fields->current; i++) {
+        GroupStep* child = &fields->steps[i];
+        if(child->running && !child->command->interruptible) return false;
     }
     return true;
 }
 
 Command* CommandGroup_getCurrentCommand(Command* group) {
-    ListNode* node = group->fields->currentNode;
-    return (node)? ((GroupEntry*) node->data)->command: NULL;
+    Fields* fields = group->fields;
+    if(!fields->started || fields->current >= fields->stepCount) return NULL;
+    return fields->steps[fields->current].command;
+}
+
+unsigned int CommandGroup_getChildCount(Command* group) {
+    return group->fields->childCount;
+}
+
+// running children, then any members racing the current step //
+Command* CommandGroup_getChild(Command* group, unsigned int index) {
+    Fields* fields = group->fields;
+    unsigned short i, last = fields->current;
+    if(CommandGroup_getCurrentCommand(group)) last = fields->steps[fields->current].next;
+    for(i = fields->firstChild; i < last; i++) {
+        if(i == fields->current || !fields->steps[i].running) continue;
+        if(index-- == 0) return fields->steps[i].command;
+    }
+    return NULL;
 }
 
-const List* CommandGroup_getChildList(Command* group) {
-    return &group->fields->children;
+// seal every group built so far, called before the arena is sealed //
+void CommandGroup_sealAll() {
+    ListNode* node = unsealedList.firstNode;
+    while(node != NULL) {
+        Command* group = node->data;
+        if(!group->fields->sealed) seal(group->fields);
+        ListNode* next = List_remove(node);
+        free(node);
+        node = next;
+    }
 }
 
 /********************************************************************
@@ -304,3 +395,17 @@ void CommandGroup_addParallelWithTimeout(Command* group, Command* cmd, float tim
     addEntryNode(group, cmd, GroupEntryState_BranchChild, timeoutSec);
     ErrorEntryClear();
 }
+
+// adjacent race members start together, the first to finish ends them all //
+void CommandGroup_addRace(Command* group, Command* cmd) {
+    ErrorEntryPoint();
+    addEntryNode(group, cmd, GroupEntryState_RaceMember, NAN);
+    ErrorEntryClear();
+}
+
+// runs in sequence, cancelling the parallel children when it finishes //
+void CommandGroup_addDeadline(Command* group, Command* cmd) {
+    ErrorEntryPoint();
+    addEntryNode(group, cmd, GroupEntryState_Deadline, NAN);
+    ErrorEntryClear();
+}
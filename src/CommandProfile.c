@@ -0,0 +1,229 @@
+//
+//  CommandProfile.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#include "API.h"
+
+#include "Command.h"
+#include "CommandProfile.h"
+#include "Histogram.h"
+#include "Clock.h"
+#include "UserInterface.h"
+#include "Arena.h"
+#include "Error.h"
+
+/********************************************************************
+ * CommandProfile Structure                                         *
+ ********************************************************************/
+
+struct CommandProfile {
+    Command*  command;
+    ListNode  node;
+    Histogram phases[COMMAND_PHASE_COUNT];
+};
+
+/********************************************************************
+ * Private API                                                      *
+ ********************************************************************/
+
+// the window's configured rows, less the header //
+#define WINDOW_RANKED_ROWS  11
+
+// profiles kept ready for Commands first timed once the arena is sealed //
+#define PROFILE_SPARES      8
+
+bool CommandProfileEnabled = false;
+static List profiles;
+static List spares;
+
+// spares first, then the arena while it is open; NULL skips profiling //
+static CommandProfile* takeProfile() {
+    if(spares.firstNode) {
+        ListNode* node = spares.firstNode;
+        List_remove(node);
+        return node->data;
+    }
+    if(Arena_isSealed()) return NULL;
+    CommandProfile* profile = Arena_alloc(sizeof(CommandProfile));
+    profile->node = (ListNode) { .data = profile };
+    return profile;
+}
+
+static void reserveSpares() {
+    while(spares.nodeCount < PROFILE_SPARES && !Arena_isSealed()) {
+        CommandProfile* profile = Arena_alloc(sizeof(CommandProfile));
+        profile->node = (ListNode) { .data = profile };
+        List_insertLast(&spares, &profile->node);
+    }
+}
+
+static CommandProfile* getProfile(Command* cmd) {
+    if(cmd->profile) return cmd->profile;
+    
+    // first timed call for this Command //
+    CommandProfile* profile = takeProfile();
+    if(profile == NULL) return NULL;
+    profile->command = cmd;
+    int i;
+    for(i = 0; i < COMMAND_PHASE_COUNT; i++) {
+        Histogram_reset(&profile->phases[i]);
+    }
+    List_insertLast(&profiles, &profile->node);
+    cmd->profile = profile;
+    return profile;
+}
+
+// inclusive time, a CommandGroup includes its children //
+static unsigned long long getTotalTime(CommandProfile* profile) {
+    unsigned long long total = 0;
+    int i;
+    for(i = 0; i < COMMAND_PHASE_COUNT; i++) {
+        total += profile->phases[i].total;
+    }
+    return total;
+}
+
+static void updateWindow(Window* win, bool full) {
+    Rect innerRect       = Window_getInnerRect(win);
+    unsigned char height = Window_getHeight(win);
+    unsigned char left   = innerRect.left;
+    unsigned char top    = innerRect.top;
+    
+    if(full) {
+        PrintTextToGD(top, left, Color_Black, "%-12s %5s %5s %5s %5s %5s\n",
+                      "Command", "Calls", "Exec", "p99", "Max", "Fin");
+    }
+    
+    // rank the most expensive Commands, one line is the header //
+    static CommandProfile*    ranked[WINDOW_RANKED_ROWS];
+    static unsigned long long totals[WINDOW_RANKED_ROWS];
+    unsigned char count = 0;
+    unsigned char slots = (height > 1)? height - 1: 0;
+    if(slots > WINDOW_RANKED_ROWS) slots = WINDOW_RANKED_ROWS;
+    ListNode* node = profiles.firstNode;
+    while(node != NULL) {
+        CommandProfile* profile  = node->data;
+        unsigned long long total = getTotalTime(profile);
+        int i = count;
+        while(i > 0 && totals[i - 1] < total) {
+            if(i < slots) {
+                ranked[i] = ranked[i - 1];
+                totals[i] = totals[i - 1];
+            }
+            i--;
+        }
+        if(i < slots) {
+            ranked[i] = profile;
+            totals[i] = total;
+            if(count < slots) count++;
+        }
+        node = node->next;
+    }
+    
+    // print the ranking, times in microseconds //
+    int i;
+    for(i = 0; i < slots; i++) {
+        if(i >= count) {
+            PrintTextToGD(top + 1 + i, left, Color_Black, "%*s\n", Window_getWidth(win), "");
+            continue;
+        }
+        Histogram* exec = &ranked[i]->phases[CommandPhase_Execute];
+        Histogram* fin  = &ranked[i]->phases[CommandPhase_IsFinished];
+        char name[13];
+        Command_formatName(ranked[i]->command, name, sizeof(name));
+        PrintTextToGD(top + 1 + i, left, Color_Black, "%-12.12s %5lu %5lu %5lu %5lu %5lu\n",
+                      name, exec->count,
+                      Histogram_getMean(exec), Histogram_getPercentile(exec, 99),
+                      exec->max, Histogram_getMean(fin));
+    }
+}
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+void CommandProfile_add(Command* cmd) {
+    getProfile(cmd);
+}
+
+void CommandProfile_record(Command* cmd, CommandPhase phase, unsigned long ticks) {
+    CommandProfile* profile = getProfile(cmd);
+    if(profile == NULL) return;
+    Histogram_add(&profile->phases[phase], Clock_ticksToMicros(ticks));
+}
+
+void CommandProfile_remove(Command* cmd) {
+    if(!cmd->profile) return;
+    List_remove(&cmd->profile->node);
+    List_insertLast(&spares, &cmd->profile->node);
+    cmd->profile = NULL;
+}
+
+/********************************************************************
+ * Public API                                                       *
+ ********************************************************************/
+
+void CommandProfile_setEnabled(bool value) {
+    CommandProfileEnabled = value;
+    if(value) reserveSpares();
+}
+
+bool CommandProfile_isEnabled() {
+    return CommandProfileEnabled;
+}
+
+void CommandProfile_reset() {
+    ListNode* node = profiles.firstNode;
+    while(node != NULL) {
+        CommandProfile* profile = node->data;
+        int i;
+        for(i = 0; i < COMMAND_PHASE_COUNT; i++) {
+            Histogram_reset(&profile->phases[i]);
+        }
+        node = node->next;
+    }
+}
+
+bool CommandProfile_getStats(Command* cmd, CommandPhase phase, CommandProfileStats* stats) {
+    ErrorIf(cmd == NULL, VEXOS_ARGNULL);
+    ErrorIf(stats == NULL, VEXOS_ARGNULL);
+    ErrorIf(phase < CommandPhase_Initialize || phase > CommandPhase_IsFinished, VEXOS_ARGRANGE);
+    
+    if(!cmd->profile) return false;
+    Histogram* hist = &cmd->profile->phases[phase];
+    stats->count      = hist->count;
+    stats->minMicros  = (hist->count > 0)? hist->min: 0;
+    stats->meanMicros = Histogram_getMean(hist);
+    stats->maxMicros  = hist->max;
+    stats->p99Micros  = Histogram_getPercentile(hist, 99);
+    return true;
+}
+
+/********************************************************************
+ * Public API (UI Hooks)                                            *
+ ********************************************************************/
+
+Window* CommandProfile_getWindow() {
+    static Window* window = NULL;
+    if(window) return window;
+    window = Window_new("Command Profile", &updateWindow);
+    Window_setSize(window, 42, WINDOW_RANKED_ROWS + 1);
+    return window;
+}
@@ -0,0 +1,67 @@
+//
+//  Coroutine.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#include "Command.h"
+#include "CommandClass.h"
+#include "Error.h"
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+void Coroutine_reset(Coroutine* co) {
+    co->line     = 0;
+    co->wakeTime = 0;
+    co->awaiting = NULL;
+}
+
+// cancel the awaited Command with the coroutine //
+void Coroutine_stop(Coroutine* co) {
+    Command* child = co->awaiting;
+    if(child == NULL) return;
+    Command_setCancelled(child);
+    Command_removed(child);
+    co->awaiting = NULL;
+}
+
+void Coroutine_await(Command* cmd, Coroutine* co, Command* child) {
+    ErrorIf(child == NULL, VEXOS_ARGNULL);
+    ErrorMsgIf(child->requireMask & ~cmd->requireMask, VEXOS_OPINVALID,
+               "Awaited Command needs a Subsystem its coroutine does not require: %s",
+               Command_getName(child));
+    
+    // the coroutine owns the Command from now on, like a CommandGroup //
+    if(child->parent != cmd) {
+        Command_setParent(child, cmd);
+    }
+    Command_startRunning(child, COMMAND_TIME_NONE);
+    co->awaiting = child;
+}
+
+// run the awaited Command once, false when it has finished //
+bool Coroutine_poll(Coroutine* co) {
+    Command* child = co->awaiting;
+    if(child == NULL) return false;
+    if(Command_run(child)) return true;
+    Command_removed(child);
+    co->awaiting = NULL;
+    return false;
+}
@@ -23,6 +23,7 @@
 
 #include "Hardware.h"
 #include "UserInterface.h"
+#include "Task.h"
 #include "Error.h"
 
 /********************************************************************
@@ -57,7 +58,7 @@ struct DebugValue {
 
 static ListNode* currentValue;
 static List debugValues;
-static unsigned long nextSampleTime;
+static Task* pullTask;
 
 static void setCurrentValue(ListNode* node) {
     currentValue = node;
@@ -74,11 +75,7 @@ static bool restoreCurrentValue() {
     return false;
 }
 
-static void pullValues(EventType type, void* state) {
-    // enforce sampling interval //
-    unsigned long time = GetMsClock();
-    if(time < nextSampleTime) return;
-
+static void pullValues(Task* task, void* state) {
     ListNode* node = debugValues.firstNode;
     while(node != NULL) {
         DebugValue* value = node->data;
@@ -111,7 +108,6 @@ static void pullValues(EventType type, void* state) {
         }
         node = node->next;
     }
-    nextSampleTime = time + SAMPLE_TIME;
 }
 
 static void updateWindow(Window* win, bool full) {
@@ -233,11 +229,9 @@ DebugValue* DebugValue_newWithFormat(String name, DebugValueType type, String fo
     value->callback    = NULL;
     List_insertLast(&debugValues, List_newNode(value));
 
-    // add the event handlers //
+    // start sampling //
     if(debugValues.nodeCount == 1) {
-        VexOS_addEventHandler(EventType_DisabledPeriodic,   &pullValues, NULL);
-        VexOS_addEventHandler(EventType_AutonomousPeriodic, &pullValues, NULL);
-        VexOS_addEventHandler(EventType_OperatorPeriodic,   &pullValues, NULL);
+        pullTask = Task_new("DebugValue", SAMPLE_TIME, TASK_PRIORITY_DEBUG, &pullValues, NULL);
     }
     return value;
 }
@@ -249,11 +243,9 @@ DebugValue* DebugValue_delete(DebugValue* value) {
     if(node == NULL) return value;
     if(currentValue == node) setCurrentValue(NULL);
     List_remove(node);
-    // check for last value and remove handlers //
+    // check for last value and stop sampling //
     if(debugValues.nodeCount == 0) {
-        VexOS_removeEventHandler(EventType_DisabledPeriodic,   &pullValues);
-        VexOS_removeEventHandler(EventType_AutonomousPeriodic, &pullValues);
-        VexOS_removeEventHandler(EventType_OperatorPeriodic,   &pullValues);
+        pullTask = Task_delete(pullTask);
     }
     free((void*) value->valueString);
     free(value);
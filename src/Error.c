@@ -39,6 +39,7 @@ static String getMessage(ErrorCode error) {
         case VEXOS_BUTTONLOCK:     return "Buttons cannot be created in constructors";
         case VEXOS_OBJTYPE:        return "Input object is not an instance of source class";
         case VEXOS_NOTINITIALIZED: return "Operation is not permitted until robot is initializing";
+        case VEXOS_NOMEMORY:       return "Out of memory";
         default:
             return "No error"; // this should not occur //
     }
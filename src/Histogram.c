@@ -0,0 +1,95 @@
+//
+//  Histogram.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#include "Histogram.h"
+
+/********************************************************************
+ * Private API                                                      *
+ ********************************************************************/
+
+static unsigned int getBucket(unsigned long value) {
+    if(value < 2) return value;
+    // position of the highest bit, plus the bit below it //
+    unsigned int msb    = (sizeof(unsigned long) * CHAR_BIT - 1) - __builtin_clzl(value);
+    unsigned int bucket = (msb << 1) | ((value >> (msb - 1)) & 1);
+    return (bucket < HISTOGRAM_BUCKETS)? bucket: (HISTOGRAM_BUCKETS - 1);
+}
+
+// largest value that maps to a bucket //
+static unsigned long getBucketLimit(unsigned int bucket) {
+    if(bucket < 2) return bucket;
+    unsigned int  msb  = bucket >> 1;
+    unsigned long half = 1UL << (msb - 1);
+    return (1UL << msb) + ((bucket & 1)? half: 0) + half - 1;
+}
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+void Histogram_reset(Histogram* hist) {
+    memset(hist, 0, sizeof(Histogram));
+    hist->min = ULONG_MAX;
+}
+
+void Histogram_add(Histogram* hist, unsigned long value) {
+    hist->count++;
+    hist->total += value;
+    if(value < hist->min) hist->min = value;
+    if(value > hist->max) hist->max = value;
+    
+    // rescale everything if the bucket is about to overflow //
+    unsigned int bucket = getBucket(value);
+    if(hist->buckets[bucket] == USHRT_MAX) {
+        int i;
+        for(i = 0; i < HISTOGRAM_BUCKETS; i++) {
+            hist->buckets[i] >>= 1;
+        }
+    }
+    hist->buckets[bucket]++;
+}
+
+unsigned long Histogram_getMean(const Histogram* hist) {
+    if(hist->count == 0) return 0;
+    return (unsigned long) (hist->total / hist->count);
+}
+
+unsigned long Histogram_getPercentile(const Histogram* hist, unsigned int percent) {
+    if(hist->count == 0) return 0;
+    
+    // find the bucket that holds the requested rank //
+    unsigned long sum = 0;
+    int i;
+    for(i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        sum += hist->buckets[i];
+    }
+    unsigned long rank = (sum * percent + 99) / 100;
+    unsigned long seen = 0;
+    for(i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += hist->buckets[i];
+        if(seen >= rank && seen > 0) break;
+    }
+    // report the bucket limit, bounded by what was actually seen //
+    unsigned long limit = getBucketLimit(i);
+    if(limit > hist->max) limit = hist->max;
+    if(limit < hist->min) limit = hist->min;
+    return limit;
+}
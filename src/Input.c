@@ -0,0 +1,180 @@
+//
+//  Input.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#include "API.h"
+
+#include "Input.h"
+#include "InputLog.h"
+
+/********************************************************************
+ * Private API                                                      *
+ ********************************************************************/
+
+#define JOYSTICK_COUNT          2
+#define JOYSTICK_ANALOG_COUNT   4   // channels 1-4
+#define JOYSTICK_DIGITAL_FIRST  5   // channels 5-8
+#define JOYSTICK_DIGITAL_COUNT  4
+#define JOYSTICK_AXIS_COUNT     2
+#define DIGITAL_PORT_COUNT      12
+#define ANALOG_PORT_COUNT       8
+
+// one coherent copy of all used inputs, refreshed each loop //
+typedef struct {
+    int            joyAnalog[JOYSTICK_COUNT][JOYSTICK_ANALOG_COUNT];
+    int            joyAccel[JOYSTICK_COUNT][JOYSTICK_AXIS_COUNT];
+    unsigned char  joyDigital[JOYSTICK_COUNT][JOYSTICK_DIGITAL_COUNT];
+    unsigned short digital;
+    unsigned short analog[ANALOG_PORT_COUNT];
+} InputSnapshot;
+
+// channels that have been read at least once //
+typedef struct {
+    bool           joyAnalog[JOYSTICK_COUNT][JOYSTICK_ANALOG_COUNT];
+    bool           joyAccel[JOYSTICK_COUNT][JOYSTICK_AXIS_COUNT];
+    unsigned char  joyDigital[JOYSTICK_COUNT][JOYSTICK_DIGITAL_COUNT];
+    unsigned short digital;
+    bool           analog[ANALOG_PORT_COUNT];
+} InputUsage;
+
+static InputSnapshot  snapshot;
+static InputUsage     used;
+// reads are live until the first loop samples //
+static bool           sampling = false;
+
+// raw reads, each one is an input channel to the log //
+static int readJoystickAnalog(unsigned char joystick, unsigned char channel) {
+    return LogInput(InputChannel_JoystickAnalog + (joystick - 1) * JOYSTICK_ANALOG_COUNT + channel - 1,
+                    GetJoystickAnalog(joystick, channel));
+}
+
+static bool readJoystickDigital(unsigned char joystick, unsigned char channel, unsigned char button) {
+    return LogInput(InputChannel_JoystickDigital + (joystick - 1) * 32
+                    + (channel - JOYSTICK_DIGITAL_FIRST) * 8 + button,
+                    GetJoystickDigital(joystick, channel, button)) != 0;
+}
+
+static int readJoystickAccelerometer(unsigned char joystick, unsigned char axis) {
+    return LogInput(InputChannel_JoystickAccel + (joystick - 1) * JOYSTICK_AXIS_COUNT + axis - 1,
+                    GetJoystickAccelerometer(joystick, axis));
+}
+
+static bool readDigital(unsigned char port) {
+    return LogInput(InputChannel_Digital + port - 1, GetDigitalInput(port)) != 0;
+}
+
+static unsigned int readAnalog(unsigned char port) {
+    return LogInput(InputChannel_AnalogHR + port - 1, GetAnalogInputHR(port));
+}
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+void Input_sample() {
+    unsigned char j, i, b;
+    for(j = 0; j < JOYSTICK_COUNT; j++) {
+        for(i = 0; i < JOYSTICK_ANALOG_COUNT; i++) {
+            if(used.joyAnalog[j][i]) {
+                snapshot.joyAnalog[j][i] = readJoystickAnalog(j + 1, i + 1);
+            }
+        }
+        for(i = 0; i < JOYSTICK_AXIS_COUNT; i++) {
+            if(used.joyAccel[j][i]) {
+                snapshot.joyAccel[j][i] = readJoystickAccelerometer(j + 1, i + 1);
+            }
+        }
+        for(i = 0; i < JOYSTICK_DIGITAL_COUNT; i++) {
+            unsigned char mask = used.joyDigital[j][i];
+            if(!mask) continue;
+            unsigned char value = 0;
+            for(b = 1; mask >> b; b++) {
+                if((mask & (1 << b)) && readJoystickDigital(j + 1, i + JOYSTICK_DIGITAL_FIRST, b)) {
+                    value |= (1 << b);
+                }
+            }
+            snapshot.joyDigital[j][i] = value;
+        }
+    }
+    if(used.digital) {
+        unsigned short value = 0;
+        for(i = 1; i <= DIGITAL_PORT_COUNT; i++) {
+            if((used.digital & (1 << i)) && readDigital(i)) {
+                value |= (1 << i);
+            }
+        }
+        snapshot.digital = value;
+    }
+    for(i = 0; i < ANALOG_PORT_COUNT; i++) {
+        if(used.analog[i]) {
+            snapshot.analog[i] = readAnalog(i + 1);
+        }
+    }
+    sampling = true;
+}
+
+int Input_getJoystickAnalog(unsigned char joystick, unsigned char channel) {
+    int* value = &snapshot.joyAnalog[joystick - 1][channel - 1];
+    if(!sampling || !used.joyAnalog[joystick - 1][channel - 1]) {
+        used.joyAnalog[joystick - 1][channel - 1] = true;
+        *value = readJoystickAnalog(joystick, channel);
+    }
+    return *value;
+}
+
+bool Input_getJoystickDigital(unsigned char joystick, unsigned char channel, unsigned char button) {
+    unsigned char  bit   = (1 << button);
+    unsigned char* value = &snapshot.joyDigital[joystick - 1][channel - JOYSTICK_DIGITAL_FIRST];
+    unsigned char* mask  = &used.joyDigital[joystick - 1][channel - JOYSTICK_DIGITAL_FIRST];
+    if(!sampling || !(*mask & bit)) {
+        *mask |= bit;
+        if(readJoystickDigital(joystick, channel, button)) *value |= bit;
+        else *value &= ~bit;
+    }
+    return (*value & bit) != 0;
+}
+
+int Input_getJoystickAccelerometer(unsigned char joystick, unsigned char axis) {
+    int* value = &snapshot.joyAccel[joystick - 1][axis - 1];
+    if(!sampling || !used.joyAccel[joystick - 1][axis - 1]) {
+        used.joyAccel[joystick - 1][axis - 1] = true;
+        *value = readJoystickAccelerometer(joystick, axis);
+    }
+    return *value;
+}
+
+bool Input_getDigital(unsigned char port) {
+    unsigned short bit = (1 << port);
+    if(!sampling || !(used.digital & bit)) {
+        used.digital |= bit;
+        if(readDigital(port)) snapshot.digital |= bit;
+        else snapshot.digital &= ~bit;
+    }
+    return (snapshot.digital & bit) != 0;
+}
+
+unsigned int Input_getAnalog(unsigned char port) {
+    unsigned short* value = &snapshot.analog[port - 1];
+    if(!sampling || !used.analog[port - 1]) {
+        used.analog[port - 1] = true;
+        *value = readAnalog(port);
+    }
+    return *value;
+}
@@ -0,0 +1,316 @@
+//
+//  InputLog.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#include "API.h"
+
+#include "InputLog.h"
+#include "Interrupt.h"
+#include "Error.h"
+
+/********************************************************************
+ * Private API                                                      *
+ ********************************************************************/
+
+// nothing is kept unless built with INPUTLOG //
+#ifdef INPUTLOG
+
+// each record is: position delta, type, payload; values are deltas //
+#define InputEvent_Interrupt    0xFD    // count, then channel and value pairs
+#define InputEvent_Run          0xFE    // run mode
+#define InputEvent_Lost         0xFF    // interrupts were dropped, replay stops
+
+#define LOG_VERSION             2
+#define LINE_BYTES              32
+#define BUFFER_BYTES            192
+#define QUEUE_SIZE              4       // must be a power of two
+#define INTERRUPT_READS         24
+
+// reads made by one interrupt, handed to the loop to be written //
+typedef struct {
+    unsigned long position;
+    unsigned char count;
+    unsigned char channel[INTERRUPT_READS];
+    long          delta[INTERRUPT_READS];
+} InterruptEntry;
+
+// last value written or replayed, loop and interrupt reads apart //
+static long           values[InputChannel_Count];
+static long           interruptValues[InputChannel_Count];
+static unsigned long  readCount;
+static unsigned long  lastPosition;
+static volatile bool  inInterrupt;
+
+// recording //
+static unsigned char  buffer[BUFFER_BYTES];
+static unsigned int   length;
+static bool           started;
+static InterruptEntry queue[QUEUE_SIZE];
+static volatile unsigned char queueHead, queueTail;
+static InterruptEntry* entry;
+static volatile bool  lost;
+
+// replaying //
+static InputLogReader* reader;
+static void*          readerState;
+static bool           replaying;
+static bool           exhausted;
+static bool           peeked;
+static unsigned long  nextPosition;
+static int            nextType;
+static int            nextRunMode;
+
+static void flush() {
+    static const char digits[] = "0123456789ABCDEF";
+    char line[LINE_BYTES * 2 + 1];
+    unsigned int i, n;
+    if(!started) {
+        PrintToScreen("#INPUT %d\n", LOG_VERSION);
+        started = true;
+    }
+    for(i = 0; i < length; i += n) {
+        n = (length - i < LINE_BYTES)? length - i: LINE_BYTES;
+        unsigned int j;
+        for(j = 0; j < n; j++) {
+            line[j * 2]     = digits[buffer[i + j] >> 4];
+            line[j * 2 + 1] = digits[buffer[i + j] & 0x0F];
+        }
+        line[n * 2] = '\0';
+        PrintToScreen("#I %s\n", line);
+    }
+    length = 0;
+}
+
+static void writeByte(unsigned char value) {
+    buffer[length++] = value;
+}
+
+static void writeVarint(unsigned long value) {
+    while(value >= 0x80) {
+        writeByte(value | 0x80);
+        value >>= 7;
+    }
+    writeByte(value);
+}
+
+// zig-zag, so small negative deltas stay short //
+static void writeValue(long delta) {
+    writeVarint(((unsigned long) delta << 1) ^ (unsigned long) (delta >> (sizeof(long) * 8 - 1)));
+}
+
+static void writeHeader(unsigned long position, unsigned char type) {
+    writeVarint(position - lastPosition);
+    writeByte(type);
+    lastPosition = position;
+}
+
+// interrupts fired before read n are written ahead of it //
+static void drainInterrupts(unsigned long position) {
+    while(queueTail != queueHead && queue[queueTail].position <= position) {
+        InterruptEntry* next = &queue[queueTail];
+        unsigned char i;
+        writeHeader(next->position, InputEvent_Interrupt);
+        writeByte(next->count);
+        for(i = 0; i < next->count; i++) {
+            writeByte(next->channel[i]);
+            writeValue(next->delta[i]);
+        }
+        queueTail = (queueTail + 1) & (QUEUE_SIZE - 1);
+        if(length >= LINE_BYTES) flush();
+    }
+    if(lost) {
+        writeHeader(position, InputEvent_Lost);
+        lost = false;
+    }
+}
+
+static int readByte() {
+    int value = (exhausted)? -1: reader(readerState);
+    if(value < 0) exhausted = true;
+    return value;
+}
+
+static unsigned long readVarint() {
+    unsigned long value = 0;
+    unsigned char shift = 0;
+    int next;
+    do {
+        next = readByte();
+        if(next < 0) return 0;
+        value |= (unsigned long) (next & 0x7F) << shift;
+        shift += 7;
+    } while(next & 0x80);
+    return value;
+}
+
+static long readValue() {
+    unsigned long value = readVarint();
+    return (long) (value >> 1) ^ -(long) (value & 1);
+}
+
+// look at the next record header without consuming it //
+static bool peek() {
+    if(peeked) return true;
+    if(exhausted) return false;
+    nextPosition += readVarint();
+    nextType = readByte();
+    if(nextType == InputEvent_Run) nextRunMode = readByte();
+    peeked = !exhausted;
+    return peeked;
+}
+
+// apply every record due before read n; interrupts run in place //
+static void replayTo(unsigned long position, InputChannel channel) {
+    while(peek() && nextPosition == position) {
+        peeked = false;
+        if(nextType < InputChannel_Count) {
+            ErrorMsgIf(nextType != channel, VEXOS_OPINVALID,
+                       "Input replay diverged at read %lu", position);
+            values[channel] += readValue();
+            return;
+        }
+        ErrorMsgIf(nextType == InputEvent_Lost, VEXOS_OPINVALID,
+                   "Input log lost interrupts at read %lu", position);
+        ErrorMsgIf(nextType != InputEvent_Interrupt, VEXOS_OPINVALID,
+                   "Input replay diverged at read %lu", position);
+        int count = readByte();
+        while(count-- > 0) {
+            int  next  = readByte();
+            long delta = readValue();
+            if(exhausted) return;
+            ErrorMsgIf(next >= InputChannel_Count, VEXOS_OPINVALID, 
+                       "Input log is corrupt at read %lu", position);
+            interruptValues[next] += delta;
+        }
+        Interrupt_run();
+    }
+    ErrorMsgIf(peek() && nextPosition < position, VEXOS_OPINVALID,
+               "Input replay diverged at read %lu", position);
+}
+
+static long replayRead(InputChannel channel) {
+    if(inInterrupt) return interruptValues[channel];
+    replayTo(readCount++, channel);
+    // an ended log ends the run it was in //
+    if(exhausted && channel == InputChannel_Enabled) return !values[channel];
+    return values[channel];
+}
+
+#endif
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+#ifdef INPUTLOG
+
+long InputLog_read(InputChannel channel, long value) {
+    if(replaying) return replayRead(channel);
+    if(inInterrupt) {
+        // interrupts only queue their reads, the loop owns the buffer //
+        if(entry == NULL || value == interruptValues[channel]) return value;
+        if(entry->count == INTERRUPT_READS) {
+            lost = true;
+            return value;
+        }
+        entry->channel[entry->count] = channel;
+        entry->delta[entry->count++] = value - interruptValues[channel];
+        interruptValues[channel] = value;
+        return value;
+    }
+    unsigned long position = readCount++;
+    drainInterrupts(position);
+    if(value != values[channel]) {
+        writeHeader(position, channel);
+        writeValue(value - values[channel]);
+        values[channel] = value;
+        // a run is ending, don't leave its last loops in the buffer //
+        if(channel == InputChannel_Enabled) flush();
+    }
+    if(length >= LINE_BYTES) flush();
+    return value;
+}
+
+void InputLog_startRun(RunMode mode) {
+    if(replaying) {
+        ErrorMsgIf(!peek() || nextType != InputEvent_Run || nextPosition != readCount,
+                   VEXOS_OPINVALID, "Input replay diverged at read %lu", readCount);
+        ErrorMsgIf(nextRunMode != mode, VEXOS_OPINVALID, "Input replay diverged at read %lu",
+                   readCount);
+        peeked = false;
+        return;
+    }
+    drainInterrupts(readCount);
+    writeHeader(readCount, InputEvent_Run);
+    writeByte(mode);
+    flush();
+}
+
+void InputLog_beginInterrupt() {
+    inInterrupt = true;
+    if(replaying) return;
+    unsigned char head = queueHead;
+    if(((head + 1) & (QUEUE_SIZE - 1)) == queueTail) {
+        // the loop fell behind, the replay can't be trusted past here //
+        entry = NULL;
+        lost  = true;
+        return;
+    }
+    entry = &queue[head];
+    entry->position = readCount;
+    entry->count    = 0;
+}
+
+void InputLog_endInterrupt() {
+    if(!replaying && entry != NULL) {
+        queueHead = (queueHead + 1) & (QUEUE_SIZE - 1);
+        entry = NULL;
+    }
+    inInterrupt = false;
+}
+
+bool InputLog_isReplaying() {
+    return replaying;
+}
+
+#endif
+
+/********************************************************************
+ * Public API                                                       *
+ ********************************************************************/
+
+void InputLog_replay(InputLogReader* logReader, void* state) {
+#ifdef INPUTLOG
+    reader      = logReader;
+    readerState = state;
+    replaying   = (logReader != NULL);
+    exhausted   = !replaying;
+#endif
+}
+
+bool InputLog_nextRun(RunMode* mode) {
+#ifdef INPUTLOG
+    if(!replaying || !peek() || nextType != InputEvent_Run) return false;
+    *mode = nextRunMode;
+    return true;
+#else
+    return false;
+#endif
+}
@@ -22,30 +22,171 @@
 #include "API.h"
 
 #include "Interrupt.h"
+#include "InputLog.h"
+#include "Clock.h"
+#include "UserInterface.h"
 #include "Error.h"
 
 /********************************************************************
  * Private API                                                      *
  ********************************************************************/
 
+#define DEFAULT_BUDGET_MICROS   1000
+
+// times in clock ticks, converted when read //
+typedef struct {
+    unsigned long      count;
+    unsigned long      last;
+    unsigned long      max;
+    unsigned long long total;
+} InterruptTiming;
+
 static bool enabled = false;
 typedef struct {
     void*             object;
     InterruptHandler* handler;
+    String            name;
     int               freq;
+    int               phase;
     int               order;
+    InterruptTiming   timing;
 } InterruptData;
 
 static int numHandlers = 0;
 static InterruptData handlers[MAX_INTERRUPT_HANDLERS];
+// handlers due in each tick of the frame, one bit per slot in order //
+static unsigned short frame[INTERRUPT_FRAME_SLOTS];
 
-static void runISR() {
-    static int count = 0;
-    for(int i = 0; i < numHandlers; i++) {
-        if(count % handlers[i].freq) continue;
+// profiling, written by the ISR and copied out by the main loop //
+static bool                   profileEnabled = false;
+static unsigned long          budget         = DEFAULT_BUDGET_MICROS;
+static InterruptTiming        tickTiming;
+static unsigned long          overruns;
+static volatile unsigned long profileSeq;
+
+#define Barrier()   __asm__ __volatile__("" ::: "memory")
+
+static void addTiming(InterruptTiming* timing, unsigned long ticks) {
+    timing->count++;
+    timing->last   = ticks;
+    timing->total += ticks;
+    if(ticks > timing->max) timing->max = ticks;
+}
+
+static void runTimed(unsigned short due) {
+    unsigned long start = Clock_getTicks();
+    unsigned long mark  = start;
+    while(due) {
+        int i = __builtin_ctz(due);
         handlers[i].handler(handlers[i].object);
+        unsigned long now = Clock_getTicks();
+        addTiming(&handlers[i].timing, now - mark);
+        mark = now;
+        due &= due - 1;
+    }
+    addTiming(&tickTiming, mark - start);
+    if(budget > 0 && Clock_ticksToMicros(mark - start) > budget) overruns++;
+    // readers can't preempt the ISR, a changed count means they were interrupted //
+    Barrier();
+    profileSeq++;
+}
+
+static void runISR() {
+    static int slot = 0;
+    LogInterruptBegin();
+    unsigned short due = frame[slot];
+    if(profileEnabled) {
+        runTimed(due);
+    } else {
+        while(due) {
+            int i = __builtin_ctz(due);
+            handlers[i].handler(handlers[i].object);
+            due &= due - 1;
+        }
+    }
+    if(++slot == INTERRUPT_FRAME_SLOTS) slot = 0;
+    LogInterruptEnd();
+}
+
+// copy a consistent snapshot, retrying if an interrupt wrote during the copy //
+static void copyTiming(InterruptTiming* dest, const InterruptTiming* src) {
+    unsigned long seq;
+    do {
+        seq = profileSeq;
+        Barrier();
+        *dest = *src;
+        Barrier();
+    } while(seq != profileSeq);
+}
+
+static void getTimingStats(const InterruptTiming* timing, unsigned long* last,
+                           unsigned long* mean, unsigned long* max)
+{
+    *last = Clock_ticksToMicros(timing->last);
+    *mean = (timing->count > 0)? Clock_ticksToMicros(timing->total / timing->count): 0;
+    *max  = Clock_ticksToMicros(timing->max);
+}
+
+// handler slots move as handlers come and go, so rebuild it all //
+static void buildFrame() {
+    int slot, i;
+    for(slot = 0; slot < INTERRUPT_FRAME_SLOTS; slot++) {
+        unsigned short due = 0;
+        for(i = 0; i < numHandlers; i++) {
+            if(slot % handlers[i].freq == handlers[i].phase) due |= (1 << i);
+        }
+        frame[slot] = due;
+    }
+}
+
+// the phase whose busiest tick has the fewest handlers, then the least total //
+static int spreadPhase(int freq) {
+    int best = 0, bestPeak = MAX_INTERRUPT_HANDLERS + 1, bestTotal = 0;
+    int phase, slot;
+    for(phase = 0; phase < freq; phase++) {
+        int peak = 0, total = 0;
+        for(slot = phase; slot < INTERRUPT_FRAME_SLOTS; slot += freq) {
+            int load = __builtin_popcount(frame[slot]);
+            if(load > peak) peak = load;
+            total += load;
+        }
+        if(peak < bestPeak || (peak == bestPeak && total < bestTotal)) {
+            best      = phase;
+            bestPeak  = peak;
+            bestTotal = total;
+        }
+    }
+    return best;
+}
+
+static void updateWindow(Window* win, bool full) {
+    Rect innerRect = Window_getInnerRect(win);
+    unsigned char left = innerRect.left;
+    unsigned char top  = innerRect.top;
+    
+    if(full) {
+        PrintTextToGD(top, left, Color_Black, "%-12s %6s %6s %6s\n",
+                      "Handler", "Last", "Mean", "Max");
+    }
+    
+    // the whole tick, then each handler in run order, times in microseconds //
+    InterruptStats stats;
+    Interrupt_getStats(&stats);
+    PrintTextToGD(top + 1, left, Color_Black, "%-12s %6lu %6lu %6lu\n", "Tick",
+                  stats.lastMicros, stats.meanMicros, stats.maxMicros);
+    PrintTextToGD(top + 2, left, (stats.overruns > 0)? Color_DarkRed: Color_Black,
+                  "Over: %6lu of %8lu\n", stats.overruns, stats.ticks);
+    int i;
+    for(i = 0; i < MAX_INTERRUPT_HANDLERS; i++) {
+        InterruptHandlerStats hstats;
+        if(!Interrupt_getHandlerStats(i, &hstats)) {
+            PrintTextToGD(top + 3 + i, left, Color_Black, "%*s\n", Window_getWidth(win), "");
+            continue;
+        }
+        PrintTextToGD(top + 3 + i, left, Color_Black, "%-12.12s %6lu %6lu %6lu\n",
+                      (hstats.name)? hstats.name: "?",
+                      hstats.lastMicros, hstats.meanMicros, hstats.maxMicros);
     }
-    count++;
 }
 
 /********************************************************************
@@ -58,18 +199,29 @@ bool Interrupt_isEnabled() {
 
 void Interrupt_enable() {
     if(enabled) return;
-    RegisterImeInterruptServiceRoutine(&runISR);
+    // a replay runs the handlers itself, where they were recorded //
+    if(!InputLog_isReplaying()) RegisterImeInterruptServiceRoutine(&runISR);
     enabled = true;
 }
 
 void Interrupt_disable() {
     if(!enabled) return;
-    UnRegisterImeInterruptServiceRoutine(&runISR);
+    if(!InputLog_isReplaying()) UnRegisterImeInterruptServiceRoutine(&runISR);
     enabled = false;
 }
 
-void Interrupt_add(void* object, InterruptHandler* handler, int freq, int order) {
+// spreads handlers of the same freq across the ticks of the frame //
+void Interrupt_add(void* object, InterruptHandler* handler, String name, int freq, int order) {
+    ErrorIf(freq < 1 || INTERRUPT_FRAME_SLOTS % freq, VEXOS_ARGRANGE);
+    Interrupt_addWithPhase(object, handler, name, freq, spreadPhase(freq), order);
+}
+
+void Interrupt_addWithPhase(void* object, InterruptHandler* handler, String name, int freq,
+                            int phase, int order)
+{
     ErrorIf(numHandlers == MAX_INTERRUPT_HANDLERS, VEXOS_OPINVALID);
+    ErrorIf(freq < 1 || INTERRUPT_FRAME_SLOTS % freq, VEXOS_ARGRANGE);
+    ErrorIf(phase < 0 || phase >= freq, VEXOS_ARGRANGE);
 
     bool lastEnabled = enabled;
     Interrupt_disable();
@@ -86,7 +238,11 @@ void Interrupt_add(void* object, InterruptHandler* handler, int freq, int order)
         } 
     }
     numHandlers++;
-    handlers[slot] = (InterruptData) { object, handler, freq, order };
+    handlers[slot] = (InterruptData) {
+        .object = object, .handler = handler, .name  = name,
+        .freq   = freq,   .phase   = phase,   .order = order
+    };
+    buildFrame();
 
     if(lastEnabled) Interrupt_enable();
 }
@@ -105,8 +261,89 @@ void Interrupt_remove(void* object, InterruptHandler* handler) {
             handlers[i] = handlers[i + 1];
         }
     }
-    if(found) numHandlers--;
+    if(found) {
+        numHandlers--;
+        buildFrame();
+    }
 
     if(lastEnabled) Interrupt_enable();
 }
 
+// one interrupt period, for callers that own the timing //
+void Interrupt_run() {
+    runISR();
+}
+
+/********************************************************************
+ * Public API                                                       *
+ ********************************************************************/
+
+void Interrupt_setProfileEnabled(bool value) {
+    profileEnabled = value;
+}
+
+bool Interrupt_isProfileEnabled() {
+    return profileEnabled;
+}
+
+void Interrupt_resetProfile() {
+    bool lastEnabled = enabled;
+    Interrupt_disable();
+    int i;
+    for(i = 0; i < numHandlers; i++) {
+        memset(&handlers[i].timing, 0, sizeof(InterruptTiming));
+    }
+    memset(&tickTiming, 0, sizeof(InterruptTiming));
+    overruns = 0;
+    if(lastEnabled) Interrupt_enable();
+}
+
+void Interrupt_setBudget(unsigned long micros) {
+    budget = micros;
+}
+
+void Interrupt_getStats(InterruptStats* stats) {
+    ErrorIf(stats == NULL, VEXOS_ARGNULL);
+    
+    InterruptTiming timing;
+    unsigned long seq;
+    do {
+        seq = profileSeq;
+        Barrier();
+        timing          = tickTiming;
+        stats->overruns = overruns;
+        Barrier();
+    } while(seq != profileSeq);
+    stats->ticks        = timing.count;
+    stats->budgetMicros = budget;
+    getTimingStats(&timing, &stats->lastMicros, &stats->meanMicros, &stats->maxMicros);
+}
+
+unsigned int Interrupt_getHandlerCount() {
+    return numHandlers;
+}
+
+// handlers are numbered in the order they run //
+bool Interrupt_getHandlerStats(unsigned int index, InterruptHandlerStats* stats) {
+    ErrorIf(stats == NULL, VEXOS_ARGNULL);
+    
+    if(index >= numHandlers) return false;
+    InterruptTiming timing;
+    copyTiming(&timing, &handlers[index].timing);
+    stats->name  = handlers[index].name;
+    stats->count = timing.count;
+    getTimingStats(&timing, &stats->lastMicros, &stats->meanMicros, &stats->maxMicros);
+    return true;
+}
+
+/********************************************************************
+ * Public API (UI Hooks)                                            *
+ ********************************************************************/
+
+Window* Interrupt_getWindow() {
+    static Window* window = NULL;
+    if(window) return window;
+    window = Window_new("Interrupts", &updateWindow);
+    Window_setSize(window, 33, 3 + MAX_INTERRUPT_HANDLERS);
+    return window;
+}
@@ -22,6 +22,7 @@
 #include "API.h"
 
 #include "VexOS.h"
+#include "Input.h"
 #include "Error.h"
 
 /********************************************************************
@@ -92,9 +93,9 @@ float Joystick_getX(Joystick* stick, JoystickHand hand) {
     ErrorIf(stick == NULL, VEXOS_ARGNULL);
 
     if(hand == JoystickHand_Left) {
-        return GetJoystickAnalog(stick->id, JoystickChannelType_LeftX) / MAX_JOYSTICK_POWER;
+        return Input_getJoystickAnalog(stick->id, JoystickChannelType_LeftX) / MAX_JOYSTICK_POWER;
     } else {
-        return GetJoystickAnalog(stick->id, JoystickChannelType_RightX) / MAX_JOYSTICK_POWER;
+        return Input_getJoystickAnalog(stick->id, JoystickChannelType_RightX) / MAX_JOYSTICK_POWER;
     }
 }
 
@@ -102,9 +103,9 @@ float Joystick_getY(Joystick* stick, JoystickHand hand) {
     ErrorIf(stick == NULL, VEXOS_ARGNULL);
 
     if(hand == JoystickHand_Left) {
-        return GetJoystickAnalog(stick->id, JoystickChannelType_LeftY) / MAX_JOYSTICK_POWER;
+        return Input_getJoystickAnalog(stick->id, JoystickChannelType_LeftY) / MAX_JOYSTICK_POWER;
     } else {
-        return GetJoystickAnalog(stick->id, JoystickChannelType_RightY) / MAX_JOYSTICK_POWER;
+        return Input_getJoystickAnalog(stick->id, JoystickChannelType_RightY) / MAX_JOYSTICK_POWER;
     }
 }
 
@@ -149,19 +150,19 @@ bool Joystick_getRawButton(Joystick* stick, JoystickHand hand, JoystickButtonTyp
     ErrorIf(stick == NULL, VEXOS_ARGNULL);
 
     JoystickButtonData data = Joystick_findButton(hand, type);
-    return GetJoystickDigital(stick->id, data.channel, data.button);
+    return Input_getJoystickDigital(stick->id, data.channel, data.button);
 }
 
 float Joystick_getAccelerometerX(Joystick* stick) {
     ErrorIf(stick == NULL, VEXOS_ARGNULL);
 
-    return GetJoystickAccelerometer(stick->id, JOYSTICK_ACCEL_X) / MAX_JOYSTICK_ACCEL;
+    return Input_getJoystickAccelerometer(stick->id, JOYSTICK_ACCEL_X) / MAX_JOYSTICK_ACCEL;
 }
 
 float Joystick_getAccelerometerY(Joystick* stick) {
     ErrorIf(stick == NULL, VEXOS_ARGNULL);
 
-    return GetJoystickAccelerometer(stick->id, JOYSTICK_ACCEL_Y) / MAX_JOYSTICK_ACCEL;
+    return Input_getJoystickAccelerometer(stick->id, JOYSTICK_ACCEL_Y) / MAX_JOYSTICK_ACCEL;
 }
 
 void Joystick_setAccelerometerXDeadband(Joystick* stick, float lower, float upper) {
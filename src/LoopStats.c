@@ -0,0 +1,149 @@
+//
+//  LoopStats.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#include "API.h"
+
+#include "LoopStats.h"
+#include "Histogram.h"
+#include "Clock.h"
+#include "UserInterface.h"
+#include "Error.h"
+
+/********************************************************************
+ * Private API                                                      *
+ ********************************************************************/
+
+#define DEFAULT_BUDGET_MICROS   20000
+
+static Histogram          periods;
+static unsigned long      budget = DEFAULT_BUDGET_MICROS;
+static unsigned long      overruns;
+static unsigned long long jitterTotal;
+static unsigned long long phaseTicks[LOOP_PHASE_COUNT];
+
+// timing of the loop in progress //
+static bool               started;
+static unsigned long      loopStartTicks;
+static unsigned long      markTicks;
+static unsigned long      lastPeriod;
+
+static void updateWindow(Window* win, bool full) {
+    Rect innerRect = Window_getInnerRect(win);
+    unsigned char left = innerRect.left;
+    unsigned char top  = innerRect.top;
+    LoopStats stats;
+    VexOS_getLoopStats(&stats);
+    PrintTextToGD(top,     left, Color_Black, "P99:  %6lu us\n", stats.p99Micros);
+    PrintTextToGD(top + 1, left, Color_Black, "Max:  %6lu us\n", stats.maxMicros);
+    PrintTextToGD(top + 2, left, Color_Black, "Jit:  %6lu us\n", stats.jitterMicros);
+    PrintTextToGD(top + 3, left, (stats.overruns > 0)? Color_DarkRed: Color_Black,
+                  "Over: %6lu\n", stats.overruns);
+    PrintTextToGD(top + 4, left, Color_Black, "Sch:  %6lu us\n", stats.schedulerMicros);
+    PrintTextToGD(top + 5, left, Color_Black, "Evt:  %6lu us\n", stats.eventsMicros);
+    PrintTextToGD(top + 6, left, Color_Black, "UI:   %6lu us\n", stats.uiMicros);
+    PrintTextToGD(top + 7, left, Color_Black, "Idle: %6.1f %%\n", stats.idleFraction * 100);
+}
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+// the next loop starts a new measurement, mode changes are not loops //
+void LoopStats_start() {
+    started = false;
+}
+
+void LoopStats_beginLoop() {
+    unsigned long ticks = Clock_getTicks();
+    if(started) {
+        unsigned long period = Clock_ticksToMicros(ticks - loopStartTicks);
+        if(periods.count > 0) {
+            jitterTotal += (period > lastPeriod)? (period - lastPeriod): (lastPeriod - period);
+        }
+        Histogram_add(&periods, period);
+        if(budget > 0 && period > budget) overruns++;
+        lastPeriod = period;
+    }
+    started        = true;
+    loopStartTicks = ticks;
+    markTicks      = ticks;
+}
+
+// attribute the time since the last mark to a phase //
+void LoopStats_mark(LoopPhase phase) {
+    unsigned long ticks = Clock_getTicks();
+    phaseTicks[phase] += ticks - markTicks;
+    markTicks = ticks;
+}
+
+/********************************************************************
+ * Public API                                                       *
+ ********************************************************************/
+
+void VexOS_getLoopStats(LoopStats* stats) {
+    ErrorIf(stats == NULL, VEXOS_ARGNULL);
+
+    unsigned long loops   = periods.count;
+    stats->loops          = loops;
+    stats->minMicros      = (loops > 0)? periods.min: 0;
+    stats->meanMicros     = Histogram_getMean(&periods);
+    stats->maxMicros      = periods.max;
+    stats->p50Micros      = Histogram_getPercentile(&periods, 50);
+    stats->p99Micros      = Histogram_getPercentile(&periods, 99);
+    stats->jitterMicros   = (loops > 1)? (unsigned long) (jitterTotal / (loops - 1)): 0;
+    stats->budgetMicros   = budget;
+    stats->overruns       = overruns;
+    // phase means per loop //
+    unsigned long* phases[LOOP_PHASE_COUNT] = {
+        &stats->schedulerMicros, &stats->eventsMicros, &stats->uiMicros, &stats->idleMicros
+    };
+    unsigned long long total = 0;
+    int i;
+    for(i = 0; i < LOOP_PHASE_COUNT; i++) {
+        *phases[i] = (loops > 0)? Clock_ticksToMicros(phaseTicks[i] / loops): 0;
+        total += phaseTicks[i];
+    }
+    stats->idleFraction = (total > 0)? ((float) phaseTicks[LoopPhase_Idle] / total): 0.0;
+}
+
+void VexOS_resetLoopStats() {
+    Histogram_reset(&periods);
+    overruns    = 0;
+    jitterTotal = 0;
+    memset(phaseTicks, 0, sizeof(phaseTicks));
+    started     = false;
+}
+
+void VexOS_setLoopBudget(unsigned long micros) {
+    budget = micros;
+}
+
+/********************************************************************
+ * Public API (UI Hooks)                                            *
+ ********************************************************************/
+
+Window* LoopStats_getWindow() {
+    static Window* window = NULL;
+    if(window) return window;
+    window = Window_new("Loop Timing", &updateWindow);
+    Window_setSize(window, 16, 8);
+    return window;
+}
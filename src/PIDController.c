@@ -48,16 +48,23 @@ struct PIDController {
     float      tolerance;
     // PID algorithm structure //
     PIDState   data;
+    ListNode   node;
 };
 
-static void pidInterrupt(void* object) {
-    PIDController* pid = object;
+static List controllers;
 
-    if(pid->enabled) {
-        // process the PID data //
-        pid->data.input = pid->pidInput(pid->state);
-        PID_calculate(&pid->data);
-        pid->pidOutput(pid->state, pid->data.output);
+// one handler runs every controller, in the order they were created //
+static void pidInterrupt(void* object) {
+    ListNode* node = controllers.firstNode;
+    while(node) {
+        PIDController* pid = node->data;
+        if(pid->enabled) {
+            // process the PID data //
+            pid->data.input = pid->pidInput(pid->state);
+            PID_calculate(&pid->data);
+            pid->pidOutput(pid->state, pid->data.output);
+        }
+        node = node->next;
     }
 }
 
@@ -80,19 +87,28 @@ PIDController* PIDController_new(PIDInput* input, PIDOutput* output, void* state
     pid->minIn     = 0.0;
     pid->maxIn     = 0.0;
     pid->tolerance = 0.0;
+    pid->node      = (ListNode) { .data = pid };
     // initialize with defaults //
     PID_initialize(&pid->data);
     
     // add the interrupt handler: at priority 9, it runs before     //
     // MotorGroup power updates, allowing low phase lag for sensors //
-    Interrupt_add(pid, &pidInterrupt, 1, 9);
+    bool lastEnabled = Interrupt_isEnabled();
+    Interrupt_disable();
+    if(controllers.nodeCount == 0) Interrupt_add(NULL, &pidInterrupt, "PID", 1, 9);
+    List_insertLast(&controllers, &pid->node);
+    if(lastEnabled) Interrupt_enable();
     return pid;
 }
 
 PIDController* PIDController_delete(PIDController* pid) {
     if(!pid) return NULL;
     if(pid->enabled) PIDController_setEnabled(pid, false);
-    Interrupt_remove(pid, &pidInterrupt);
+    bool lastEnabled = Interrupt_isEnabled();
+    Interrupt_disable();
+    List_remove(&pid->node);
+    if(controllers.nodeCount == 0) Interrupt_remove(NULL, &pidInterrupt);
+    if(lastEnabled) Interrupt_enable();
     free(pid);
     return pid;
 }
@@ -38,124 +38,142 @@
 #include "CommandGroup.h"
 #include "Subsystem.h"
 #include "UserInterface.h"
+#include "Trace.h"
 #include "Error.h"
 
 /********************************************************************
  * Private API                                                      *
  ********************************************************************/
 
-static ListNode* getNode(void*);
-static void freeNode(ListNode*);
-static void addRunningNode(ListNode*);
-static void removeRunningNode(ListNode*);
+static void addRunningCommand(Command*);
+static void removeRunningCommand(Command*);
+static void addDefaultCommands();
 
-static List runningList;
+// one running list per priority, run highest first //
+static List runningLists[COMMAND_PRIORITY_COUNT];
+// running but asleep, off the loop until the timer wheel wakes them //
+static List sleepingList;
 static List queuedList;
 static List buttonList;
-static List nodeCache;
+
+#ifdef BENCH
+unsigned long Scheduler_visits;
+#endif
+
+// Subsystems currently owned by a running Command //
+static unsigned long claimedMask;
+// Subsystems waiting for a default Command, or blocked from starting one //
+static unsigned long pendingDefaults;
+static unsigned long blockedDefaults;
 
 typedef struct {
     unsigned int objectId;
     Color        color;
 } DisplayLine;
 
-static ListNode* getNode(void* data) {
-    ListNode* node = nodeCache.firstNode;
-    if(node != NULL) {
-        List_remove(node);
-        node->data = data;
-    } else {
-        node = List_newNode(data);
-    }
-    return node;
+static bool isRunning(Command* cmd) {
+    return (cmd->runNode.list == &runningLists[cmd->priority] || cmd->runNode.list == &sleepingList);
 }
 
-static void freeNode(ListNode* node) {
-    List_insertLast(&nodeCache, node);
+// priority decides, interruptible only matters between equals //
+static bool canPreempt(Command* cmd, Command* current) {
+    if(cmd->priority != current->priority) return (cmd->priority > current->priority);
+    return current->interruptible;
 }
 
-static void addRunningNode(ListNode* node) {
+static void addRunningCommand(Command* cmd) {
     static bool adding = false;
     
     // validate //
-    if(node == NULL) return;
-    Command* cmd = (Command*) node->data;
-    if(cmd == NULL) { freeNode(node); return; }
+    if(cmd == NULL) return;
+    List_remove(&cmd->queueNode);
     
     if(adding) {
         Info("Cannot start command during cancel(). Ignoring: %s", Command_getName(cmd));
-        freeNode(node);
         return;
     }
     
     // make sure command is not already running //
-    ListNode* xnode = runningList.firstNode;
-    while(xnode != NULL) {
-        if((Command*)xnode->data == cmd) {
-            freeNode(node);
-            return;
-        }
-        xnode = xnode->next;
-    }
+    if(isRunning(cmd)) return;
     
     // check that required Subsystems are available //
     Command* current;
-    xnode = cmd->requiresList.firstNode;
-    while(xnode != NULL) {
-        current = ((Subsystem*) xnode->data)->currentCommand;
-        if(current && !current->interruptible) {
-            freeNode(node);
-            return;
-        }
-        xnode = xnode->next;
+    unsigned long conflicts = cmd->requireMask & claimedMask;
+    unsigned long mask = conflicts;
+    while(mask) {
+        current = SubsystemTable[__builtin_ctzl(mask)]->currentCommand;
+        if(!canPreempt(cmd, current)) return;
+        mask &= mask - 1;
     }
     
-    // claim required Subsystems //
+    // cancel the current owners of required Subsystems //
     adding = true;
-    xnode = cmd->requiresList.firstNode;
-    while(xnode != NULL) {
-        Subsystem* sys = (Subsystem*) xnode->data;
-        current = sys->currentCommand;
-        if(current) {
-            Command_cancel(current);
-            // find the node with the command and remove it //
-            ListNode* xnode2 = runningList.firstNode;
-            while(xnode2 != NULL) {
-                if((Command*)xnode2->data == current) {
-                    removeRunningNode(xnode2);
-                    break;
-                }
-                xnode2 = xnode2->next;
-            }
-        }
-        sys->currentCommand = cmd;
-        xnode = xnode->next;
+    while(conflicts) {
+        current = SubsystemTable[__builtin_ctzl(conflicts)]->currentCommand;
+        Trace(TraceEvent_CommandPreempted, current, current->objectId);
+        Command_cancel(current);
+        removeRunningCommand(current);
+        conflicts &= ~current->requireMask;
     }
     adding = false;
     
+    // claim required Subsystems //
+    mask = cmd->requireMask;
+    while(mask) {
+        SubsystemTable[__builtin_ctzl(mask)]->currentCommand = cmd;
+        mask &= mask - 1;
+    }
+    claimedMask |= cmd->requireMask;
+    
     // add to command list //
-    List_insertLast(&runningList, node);
-    Command_startRunning(cmd);
+    List_insertLast(&runningLists[cmd->priority], &cmd->runNode);
+    Command_startRunning(cmd, COMMAND_TIME_NONE);
+    Trace(TraceEvent_CommandStart, cmd, cmd->objectId);
 }
 
-static void removeRunningNode(ListNode* node) {
-    if(node == NULL) return;
-    Command* cmd = (Command*) node->data;
-    if(cmd == NULL) return;
+static void removeRunningCommand(Command* cmd) {
+    if(cmd == NULL || !isRunning(cmd)) return;
     
     // remove from linked list //
-    freeNode(node);
+    List_remove(&cmd->runNode);
     
     // clear all owned Subsystems //
-    ListNode* xnode = cmd->requiresList.firstNode;
-    while(xnode != NULL) {
-        ((Subsystem*) xnode->data)->currentCommand = NULL;
-        xnode = xnode->next;
+    unsigned long mask = cmd->requireMask;
+    while(mask) {
+        SubsystemTable[__builtin_ctzl(mask)]->currentCommand = NULL;
+        mask &= mask - 1;
     }
+    claimedMask &= ~cmd->requireMask;
+    
+    // freed Subsystems may start defaults, blocked defaults may now fit //
+    pendingDefaults |= cmd->requireMask | blockedDefaults;
+    blockedDefaults  = 0;
     
     Command_removed(cmd);
 }
 
+static void addDefaultCommands() {
+    // only for Subsystems freed since last time //
+    unsigned long mask = pendingDefaults & ~claimedMask;
+    pendingDefaults &= ~mask;
+    while(mask) {
+        unsigned long bit = mask & -mask;
+        mask &= mask - 1;
+        // may have been claimed by an earlier default //
+        if(claimedMask & bit) continue;
+        Command* cmd = SubsystemTable[__builtin_ctzl(bit)]->defaultCommand;
+        if(cmd == NULL) continue;
+        if(!cmd->runWhenDisabled && VexOS_getRunMode() == RunMode_Initialize) {
+            blockedDefaults |= bit;
+            continue;
+        }
+        addRunningCommand(cmd);
+        if(!isRunning(cmd)) {
+            blockedDefaults |= bit;
+        }
+    }
+}
+
 static void printCommands(Command* cmd, DisplayLine* cache, unsigned char* line, int indent,
     Rect innerRect, unsigned char height, unsigned char width) 
 {
@@ -164,7 +182,16 @@ static void printCommands(Command* cmd, DisplayLine* cache, unsigned char* line,
 
     // NULL indicates root node, print scheduler Commands //
     if(!cmd) {
-        ListNode* node = runningList.firstNode;
+        ListNode* node;
+        int priority;
+        for(priority = COMMAND_PRIORITY_COUNT - 1; priority >= 0; priority--) {
+            node = runningLists[priority].firstNode;
+            while(node != NULL) {
+                printCommands(node->data, cache, line, indent, innerRect, height, width);
+                node = node->next;
+            }
+        }
+        node = sleepingList.firstNode;
         while(node != NULL) {
             printCommands(node->data, cache, line, indent, innerRect, height, width);
             node = node->next;
@@ -174,9 +201,9 @@ static void printCommands(Command* cmd, DisplayLine* cache, unsigned char* line,
     
     // determine line color //
     Color color = Color_Black;
-    if(cmd->startTime == -1) {
+    if(cmd->startTime == COMMAND_TIME_NONE) {
         color = Color_DarkYellow;
-    } else if(Command_timeSinceInitialized(cmd) < 1000) {
+    } else if(Command_msSinceInitialized(cmd) < 1000) {
         color = Color_DarkGreen;
     }
 
@@ -187,19 +214,19 @@ static void printCommands(Command* cmd, DisplayLine* cache, unsigned char* line,
         unsigned char left   = innerRect.left;
         unsigned char xwidth = width - indent;
         // print command and increment line counter //
-        PrintTextToGD(top, left, color, "%*s%-*.*s\n", indent, "", xwidth, xwidth, 
-                      Command_getName(cmd));
+        char name[COMMAND_NAME_MAX];
+        Command_formatName(cmd, name, sizeof(name));
+        PrintTextToGD(top, left, color, "%*s%-*.*s\n", indent, "", xwidth, xwidth, name);
         cache[*line] = (DisplayLine) { .objectId = cmd->objectId, .color = color };
     }
     (*line)++;
     // test for CommandGroup //
     if(CommandGroup_isGroup(cmd)) {
         // print children //
-        ListNode* node = CommandGroup_getChildList(cmd)->firstNode;
-        while(node != NULL) {
-            GroupEntry* entry = node->data;
-            printCommands(entry->command, cache, line, indent + 2, innerRect, height, width);
-            node = node->next;
+        Command* child;
+        unsigned int i;
+        for(i = 0; (child = CommandGroup_getChild(cmd, i)) != NULL; i++) {
+            printCommands(child, cache, line, indent + 2, innerRect, height, width);
         }
         // print current node last //
         Command* xcmd = CommandGroup_getCurrentCommand(cmd);
@@ -242,13 +269,48 @@ static void updateWindow(Window* win, bool full) {
  ********************************************************************/
 
 void Scheduler_add(Command* cmd) {
-    if(cmd == NULL) return;
-    List_insertLast(&queuedList, getNode(cmd));
+    if(cmd == NULL || cmd->queueNode.list != NULL) return;
+    List_insertLast(&queuedList, &cmd->queueNode);
+}
+
+// queued, or running and not on its way out //
+bool Scheduler_isScheduled(Command* cmd) {
+    if(cmd == NULL) return false;
+    if(cmd->queueNode.list != NULL) return true;
+    return (isRunning(cmd) && !(cmd->status & CommandStatus_Cancelled));
+}
+
+// back onto the loop, after the Commands already there //
+void Scheduler_wake(Command* cmd) {
+    if(cmd->runNode.list != &sleepingList) return;
+    List_remove(&cmd->runNode);
+    List_insertLast(&runningLists[cmd->priority], &cmd->runNode);
+}
+
+// every sleeper is visited once more, so a run mode change reaches it //
+void Scheduler_wakeAll() {
+    ListNode* node = sleepingList.firstNode;
+    while(node != NULL) {
+        ListNode* next = node->next;
+        Scheduler_wake(node->data);
+        node = next;
+    }
+}
+
+// a running Command moves to the end of its new priority //
+void Scheduler_setPriority(Command* cmd, CommandPriority priority) {
+    if(cmd->priority == priority) return;
+    bool running = (cmd->runNode.list == &runningLists[cmd->priority]);
+    cmd->priority = priority;
+    if(running) {
+        List_remove(&cmd->runNode);
+        List_insertLast(&runningLists[priority], &cmd->runNode);
+    }
 }
 
 void Scheduler_addButtonScheduler(ButtonScheduler* sched) {
     if(sched == NULL) return;
-    List_insertLast(&buttonList, getNode(sched));
+    List_insertLast(&buttonList, List_newNode(sched));
 }
 
 void Scheduler_removeButtonSchedulers(Button* button) {
@@ -257,8 +319,10 @@ void Scheduler_removeButtonSchedulers(Button* button) {
     while(node != NULL) {
         ButtonScheduler* sched = node->data;
         if(Button_getSchedulerButton(sched) == button) {
-            node = List_remove(node);
-            free(sched);
+            ListNode* next = List_remove(node);
+            free(node);
+            Button_deleteScheduler(sched);
+            node = next;
             continue;
         }
         node = node->next;
@@ -269,39 +333,56 @@ void Scheduler_run() {
     // handle buttons (go backwards to preserve priority) //
     ListNode* node = buttonList.lastNode;
     while(node != NULL) {
+        CountVisit();
         Button_executeScheduler((ButtonScheduler*) node->data);
         node = node->prev;
     }
     
-    // loop through commands to execute //
-    node = runningList.firstNode;
+    // loop through commands to execute, highest priority first //
     ListNode* temp;
-    while(node != NULL) {
-        temp = node->next;
-        if(!Command_run((Command*) node->data)) {
-            removeRunningNode(node);
+    int priority;
+    for(priority = COMMAND_PRIORITY_COUNT - 1; priority >= 0; priority--) {
+        node = runningLists[priority].firstNode;
+        while(node != NULL) {
+            CountVisit();
+            temp = node->next;
+            Command* cmd = node->data;
+            if(!Command_run(cmd)) {
+                removeRunningCommand(cmd);
+                // held by a button, restart it without waiting a loop //
+                if(cmd->status & CommandStatus_Held) Scheduler_add(cmd);
+            } else if(cmd->status & CommandStatus_Sleeping) {
+                // not visited again until the timer wheel wakes it //
+                List_remove(&cmd->runNode);
+                List_insertLast(&sleepingList, &cmd->runNode);
+            }
+            node = temp;
         }
-        node = temp;
     }
     
     // add queued stuff //
     node = queuedList.firstNode;
     while(node != NULL) {
+        CountVisit();
         temp = node->next;
-        addRunningNode(node);
+        addRunningCommand((Command*) node->data);
         node = temp;
     }
     
     // add in the defaults //
-    node = Subsystems.firstNode;
-    while(node != NULL) {
-        Subsystem* sys = (Subsystem*) node->data;
-        if(!sys->currentCommand) {
-            Command* xcmd = Subsystem_getDefaultCommand(sys);
-            addRunningNode(getNode(xcmd));
-        }
-        node = node->next;
-    }
+    addDefaultCommands();
+}
+
+void Scheduler_resetDefaults() {
+    unsigned int count = Subsystems.nodeCount;
+    pendingDefaults = (count < MAX_SUBSYSTEMS)? (1UL << count) - 1: ~0UL;
+    blockedDefaults = 0;
+    addDefaultCommands();
+}
+
+void Scheduler_wakeDefault(Subsystem* sys) {
+    if(sys == NULL) return;
+    pendingDefaults |= sys->requireBit;
 }
 
 /********************************************************************
@@ -34,13 +34,15 @@
 #include "Subsystem.h"
 #include "Hardware.h"
 #include "Device.h"
+#include "Scheduler.h"
 
 /********************************************************************
  * Protected API                                                    *
  ********************************************************************/
 
 extern struct Robot Robot;
-List Subsystems;
+List       Subsystems;
+Subsystem* SubsystemTable[MAX_SUBSYSTEMS];
 
 // hidden method, not in header //
 void Subsystem_construct() {
@@ -48,7 +50,12 @@ void Subsystem_construct() {
     Subsystem* sys;
     while((sys = Robot.subsystems[i++])) {
         if(sys->initialized) continue;
+        ErrorMsgIf(Subsystems.nodeCount >= MAX_SUBSYSTEMS, VEXOS_OPINVALID,
+                   "Too many Subsystems, maximum is %d", MAX_SUBSYSTEMS);
         *(sys->selfPtr)  = sys;
+        // assign the requirement bit //
+        SubsystemTable[Subsystems.nodeCount] = sys;
+        sys->requireBit = (1UL << Subsystems.nodeCount);
         // call constructor //
         Device_setSubsystem(sys);
         if(sys->constructor) sys->constructor();
@@ -79,6 +86,7 @@ void Subsystem_setDefaultCommand(Subsystem* sys, Command* cmd) {
                    "Default command must require subsystem: %s", Command_getName(cmd));
         sys->defaultCommand = cmd;
     }
+    Scheduler_wakeDefault(sys);
 }
 
 /********************************************************************
@@ -0,0 +1,245 @@
+//
+//  Task.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#include "API.h"
+
+#include "Task.h"
+#include "Clock.h"
+#include "UserInterface.h"
+#include "Error.h"
+
+/********************************************************************
+ * Private API                                                      *
+ ********************************************************************/
+
+struct Task {
+    String             name;
+    unsigned long      period;
+    unsigned char      priority;
+    TaskHandler*       handler;
+    void*              state;
+    unsigned long      deadline;
+    bool               enabled;
+    // a Task deleted from its own handler is freed once the handler returns //
+    bool               running;
+    bool               deleted;
+    // in the deadline queue while enabled //
+    ListNode           queueNode;
+    ListNode           taskNode;
+    // statistics //
+    unsigned long      runs;
+    unsigned long      overruns;
+    unsigned long long jitterTotal;
+    unsigned long      maxJitter;
+    unsigned long      lastMicros;
+    unsigned long      maxMicros;
+};
+
+// enabled Tasks sorted by deadline, then priority //
+static List queue;
+static List tasks;
+
+// true if a should be run before b //
+static bool isBefore(Task* a, Task* b) {
+    long diff = (long) (a->deadline - b->deadline);
+    return (diff < 0) || (diff == 0 && a->priority > b->priority);
+}
+
+static void enqueue(Task* task) {
+    List_remove(&task->queueNode);
+    ListNode* node = queue.lastNode;
+    while(node != NULL && isBefore(task, node->data)) {
+        node = node->prev;
+    }
+    if(node == NULL) {
+        List_insertFirst(&queue, &task->queueNode);
+    } else {
+        List_insertAfter(node, &task->queueNode);
+    }
+}
+
+static void runTask(Task* task, unsigned long time) {
+    // lateness of this release //
+    unsigned long jitter = time - task->deadline;
+    task->jitterTotal += jitter;
+    if(jitter > task->maxJitter) task->maxJitter = jitter;
+    
+    unsigned long start = Clock_getTicks();
+    task->handler(task, task->state);
+    task->lastMicros = Clock_ticksToMicros(Clock_getTicks() - start);
+    if(task->lastMicros > task->maxMicros) task->maxMicros = task->lastMicros;
+    task->runs++;
+    
+    // next release, skip whole periods that were missed //
+    task->deadline += task->period;
+    if((long) (time - task->deadline) >= 0) {
+        task->overruns += (time - task->deadline) / task->period + 1;
+        task->deadline  = time + task->period;
+    }
+}
+
+static void updateWindow(Window* win, bool full) {
+    Rect innerRect       = Window_getInnerRect(win);
+    unsigned char height = Window_getHeight(win);
+    unsigned char left   = innerRect.left;
+    unsigned char top    = innerRect.top;
+    
+    if(full) {
+        PrintTextToGD(top, left, Color_Black, "%-12s %5s %5s %5s %5s\n",
+                      "Task", "Runs", "Over", "Jit", "Max");
+    }
+    unsigned char line = 1;
+    ListNode* node = tasks.firstNode;
+    while(node != NULL && line < height) {
+        TaskStats stats;
+        Task* task = node->data;
+        Task_getStats(task, &stats);
+        PrintTextToGD(top + line, left, (stats.overruns > 0)? Color_DarkRed: Color_Black, 
+                      "%-12.12s %5lu %5lu %5lu %5lu\n", task->name, stats.runs, stats.overruns, 
+                      stats.maxJitterMs, stats.maxMicros);
+        node = node->next;
+        line++;
+    }
+}
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+void Task_runDue() {
+    unsigned long time = VexOS_getRunTimeMs();
+    // only the head can be due first, so idle Tasks cost nothing //
+    while(queue.firstNode != NULL) {
+        Task* task = queue.firstNode->data;
+        if((long) (time - task->deadline) < 0) return;
+        List_remove(&task->queueNode);
+        task->running = true;
+        runTask(task, time);
+        task->running = false;
+        // the handler may have deleted or disabled the Task //
+        if(task->deleted) {
+            free(task);
+        } else if(task->enabled) {
+            enqueue(task);
+        }
+    }
+}
+
+/********************************************************************
+ * Public API                                                       *
+ ********************************************************************/
+
+Task* Task_new(String name, unsigned long periodMs, unsigned char priority, 
+               TaskHandler* handler, void* state) 
+{
+    ErrorIf(name == NULL, VEXOS_ARGNULL);
+    ErrorIf(handler == NULL, VEXOS_ARGNULL);
+    ErrorIf(periodMs == 0, VEXOS_ARGRANGE);
+    
+    Task* task = malloc(sizeof(Task));
+    memset(task, 0, sizeof(Task));
+    task->name      = name;
+    task->period    = periodMs;
+    task->priority  = priority;
+    task->handler   = handler;
+    task->state     = state;
+    task->queueNode = (ListNode) { .data = task };
+    task->taskNode  = (ListNode) { .data = task };
+    List_insertLast(&tasks, &task->taskNode);
+    Task_setEnabled(task, true);
+    return task;
+}
+
+Task* Task_delete(Task* task) {
+    if(task) {
+        List_remove(&task->queueNode);
+        List_remove(&task->taskNode);
+        if(task->running) {
+            task->deleted = true;
+        } else {
+            free(task);
+        }
+    }
+    return NULL;
+}
+
+String Task_getName(Task* task) {
+    ErrorIf(task == NULL, VEXOS_ARGNULL);
+    
+    return task->name;
+}
+
+unsigned long Task_getPeriod(Task* task) {
+    ErrorIf(task == NULL, VEXOS_ARGNULL);
+    
+    return task->period;
+}
+
+void Task_setPeriod(Task* task, unsigned long periodMs) {
+    ErrorIf(task == NULL, VEXOS_ARGNULL);
+    ErrorIf(periodMs == 0, VEXOS_ARGRANGE);
+    
+    task->period = periodMs;
+}
+
+bool Task_isEnabled(Task* task) {
+    ErrorIf(task == NULL, VEXOS_ARGNULL);
+    
+    return task->enabled;
+}
+
+void Task_setEnabled(Task* task, bool value) {
+    ErrorIf(task == NULL, VEXOS_ARGNULL);
+    
+    if(value == task->enabled) return;
+    task->enabled = value;
+    if(value) {
+        // first release is immediate //
+        task->deadline = VexOS_getRunTimeMs();
+        enqueue(task);
+    } else {
+        List_remove(&task->queueNode);
+    }
+}
+
+void Task_getStats(Task* task, TaskStats* stats) {
+    ErrorIf(task == NULL, VEXOS_ARGNULL);
+    ErrorIf(stats == NULL, VEXOS_ARGNULL);
+    
+    stats->runs         = task->runs;
+    stats->overruns     = task->overruns;
+    stats->meanJitterMs = (task->runs > 0)? (unsigned long) (task->jitterTotal / task->runs): 0;
+    stats->maxJitterMs  = task->maxJitter;
+    stats->lastMicros   = task->lastMicros;
+    stats->maxMicros    = task->maxMicros;
+}
+
+/********************************************************************
+ * Public API (UI Hooks)                                            *
+ ********************************************************************/
+
+Window* Task_getWindow() {
+    static Window* window = NULL;
+    if(window) return window;
+    window = Window_new("Tasks", &updateWindow);
+    Window_setSize(window, 36, 8);
+    return window;
+}
@@ -21,6 +21,7 @@
 
 #include "API.h"
 
+#include "InputLog.h"
 #include "Error.h"
 
 /********************************************************************
@@ -96,5 +97,5 @@ void Timer_preset(Timer* timer, float timeSec) {
 float Timer_get(Timer* timer) {
     ErrorIf(timer == NULL, VEXOS_ARGNULL);
 
-    return (GetTimer(timer->id) / 1000.0);
+    return (LogInput(InputChannel_Timer + timer->id - 1, GetTimer(timer->id)) / 1000.0);
 }
@@ -0,0 +1,117 @@
+//
+//  TimerWheel.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#include "API.h"
+
+#include "TimerWheel.h"
+#include "Error.h"
+
+/********************************************************************
+ * Private API                                                      *
+ ********************************************************************/
+
+static List          slots[TIMERWHEEL_LEVELS][TIMERWHEEL_SLOTS];
+static unsigned long wheelTime;
+static unsigned int  pendingCount;
+
+static void place(WheelTimer* timer) {
+    unsigned long delta = timer->expires - wheelTime;
+    unsigned long when  = timer->expires;
+    int level = 0;
+    while(level < TIMERWHEEL_LEVELS - 1 && delta >= (1UL << (TIMERWHEEL_SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    // beyond the last level, park in its furthest slot //
+    unsigned long range = 1UL << (TIMERWHEEL_SLOT_BITS * TIMERWHEEL_LEVELS);
+    if(delta >= range) when = wheelTime + range - 1;
+    unsigned int slot = (when >> (TIMERWHEEL_SLOT_BITS * level)) & (TIMERWHEEL_SLOTS - 1);
+    List_insertLast(&slots[level][slot], &timer->node);
+}
+
+// move the timers of a higher level slot down as its turn comes //
+static bool cascade(int level) {
+    unsigned int slot = (wheelTime >> (TIMERWHEEL_SLOT_BITS * level)) & (TIMERWHEEL_SLOTS - 1);
+    List* list = &slots[level][slot];
+    while(list->firstNode != NULL) {
+        ListNode* node = list->firstNode;
+        List_remove(node);
+        place(node->data);
+    }
+    return (slot == 0);
+}
+
+static void expire(List* list) {
+    while(list->firstNode != NULL) {
+        ListNode* node = list->firstNode;
+        List_remove(node);
+        pendingCount--;
+        WheelTimer* timer = node->data;
+        timer->handler(timer);
+    }
+}
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+// a timer already due fires before this returns //
+void TimerWheel_add(WheelTimer* timer, unsigned long expires) {
+    TimerWheel_remove(timer);
+    timer->node.data = timer;
+    timer->expires   = expires;
+    if((long) (expires - wheelTime) <= 0) {
+        timer->handler(timer);
+        return;
+    }
+    pendingCount++;
+    place(timer);
+}
+
+void TimerWheel_remove(WheelTimer* timer) {
+    if(timer->node.list == NULL) return;
+    List_remove(&timer->node);
+    pendingCount--;
+}
+
+bool TimerWheel_isPending(WheelTimer* timer) {
+    return (timer->node.list != NULL);
+}
+
+// every millisecond is visited, but an idle wheel jumps ahead //
+void TimerWheel_advance(unsigned long timeMs) {
+    while((long) (timeMs - wheelTime) > 0) {
+        if(pendingCount == 0) {
+            wheelTime = timeMs;
+            return;
+        }
+        wheelTime++;
+        int level = 0;
+        unsigned int slot = wheelTime & (TIMERWHEEL_SLOTS - 1);
+        if(slot == 0) {
+            while(++level < TIMERWHEEL_LEVELS && cascade(level));
+        }
+        expire(&slots[0][slot]);
+    }
+}
+
+unsigned long TimerWheel_getTime() {
+    return wheelTime;
+}
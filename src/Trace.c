@@ -0,0 +1,108 @@
+//
+//  Trace.c
+//  VexOS for Vex Cortex
+//
+//  Created by Jeff Malins on 01/12/2013.
+//  Copyright (c) 2013 Jeff Malins. All rights reserved.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published 
+//  by the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.  
+//
+
+#include "API.h"
+
+#include "Trace.h"
+#include "Command.h"
+#include "Clock.h"
+#include "Error.h"
+
+/********************************************************************
+ * Private API                                                      *
+ ********************************************************************/
+
+// nothing is kept unless built with TRACE //
+#ifdef TRACE
+
+static TraceRecord  records[TRACE_CAPACITY];
+static unsigned int head;
+static unsigned int count;
+
+static TraceRecord* getRecord(unsigned int n) {
+    return &records[(head - count + n) & (TRACE_CAPACITY - 1)];
+}
+
+static bool isButtonEvent(unsigned char event) {
+    return (event == TraceEvent_ButtonPressed || event == TraceEvent_ButtonReleased);
+}
+
+// name each object once, before its first record //
+static void dumpName(unsigned int n) {
+    TraceRecord* record = getRecord(n);
+    if(record->object == NULL) return;
+    bool button = isButtonEvent(record->event);
+    unsigned int i;
+    for(i = 0; i < n; i++) {
+        TraceRecord* prev = getRecord(i);
+        if(prev->objectId == record->objectId && isButtonEvent(prev->event) == button) return;
+    }
+    if(button) {
+        PrintToScreen("#NAME B %u %s\n", record->objectId, Button_getName((Button*) record->object));
+    } else {
+        char name[COMMAND_NAME_MAX];
+        Command_formatName((Command*) record->object, name, sizeof(name));
+        PrintToScreen("#NAME C %u %s\n", record->objectId, name);
+    }
+}
+
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+void Trace_record(TraceEvent event, const void* object, unsigned int objectId) {
+    TraceRecord* record = &records[head];
+    head = (head + 1) & (TRACE_CAPACITY - 1);
+    if(count < TRACE_CAPACITY) count++;
+    record->ticks    = Clock_getTicks();
+    record->object   = object;
+    record->objectId = objectId;
+    record->event    = event;
+}
+
+#endif // TRACE
+
+/********************************************************************
+ * Public API                                                       *
+ ********************************************************************/
+
+// text dump for etc/trace/trace2chrome, oldest record first //
+void Trace_dump() {
+#ifdef TRACE
+    PrintToScreen("#TRACE 1 %lu %u\n", Clock_getTicksPerMicro(), count);
+    unsigned int i;
+    for(i = 0; i < count; i++) {
+        TraceRecord* record = getRecord(i);
+        dumpName(i);
+        PrintToScreen("#T %lu %u %u\n", record->ticks, record->event, record->objectId);
+    }
+    PrintToScreen("#ENDTRACE\n");
+#else
+    PrintToScreen("#TRACE not compiled in, build with -D TRACE\n");
+#endif
+}
+
+void Trace_clear() {
+#ifdef TRACE
+    head  = 0;
+    count = 0;
+#endif
+}
@@ -24,6 +24,15 @@
 #include "Interrupt.h"
 #include "UserInterface.h"
 #include "Scheduler.h"
+#include "CommandGroup.h"
+#include "Clock.h"
+#include "Input.h"
+#include "InputLog.h"
+#include "LoopStats.h"
+#include "Task.h"
+#include "TimerWheel.h"
+#include "Trace.h"
+#include "Arena.h"
 #include "Error.h"
 
 /********************************************************************
@@ -45,13 +54,25 @@ typedef struct {
 } EventData;
 
 // run loop processing //
-#define LOOP_SAMPLE     101
+#define LOOP_SAMPLE         101
+#define MAX_LOOP_FREQUENCY  1000
 static RunMode       runMode;
 static RunMode       lastRunMode;
 static unsigned long lastTime;
 static unsigned long loopTime;
 static unsigned int  loopCount;
 
+// loop pacing, a period of 0 is free-running //
+static unsigned long loopPeriod;
+static unsigned long loopDeadline;
+
+// run time, latched once per loop //
+static unsigned long runTimeMs;
+static unsigned long runTimeMicros;
+static unsigned long lastTicks;
+static unsigned long tickRemainder;
+static unsigned long microRemainder;
+
 // program name //
 static String programName;
 
@@ -64,20 +85,77 @@ static void setRunMode(RunMode mode) {
     GlobalData(GLOBALDATA_LAST_RUN_MODE) = mode;
 }
 
+static void latchRunTime() {
+    // accumulate with remainders, keeps the math 32-bit //
+    unsigned long ticks = Clock_getTicks();
+    unsigned long delta = (ticks - lastTicks) + tickRemainder;
+    lastTicks = ticks;
+    unsigned long perMicro = Clock_getTicksPerMicro();
+    unsigned long micros   = delta / perMicro;
+    tickRemainder  = delta - micros * perMicro;
+    // elapsed time is an input, a replay gets the recorded value //
+    micros         = LogInput(InputChannel_Clock, micros);
+    runTimeMicros += micros;
+    micros        += microRemainder;
+    runTimeMs     += micros / 1000;
+    microRemainder = micros % 1000;
+}
+
 static void loopStart() {
     loopCount = 0;
+    latchRunTime();
+    LoopStats_start();
+    loopDeadline = Clock_getTicks() + loopPeriod;
+    // the run mode changed, sleeping Commands must see it and every //
+    // Subsystem gets its default again                               //
+    Scheduler_wakeAll();
+    Scheduler_resetDefaults();
 }
 
 static void loopPeriodic() {
     // handle global timing //
-    unsigned long time = GetMsClock();
+    LoopStats_beginLoop();
+    latchRunTime();
+    Trace(TraceEvent_Loop, NULL, 0);
+    unsigned long time = runTimeMs;
+    // expire timeouts and wake sleeping commands //
+    TimerWheel_advance(time);
     if(loopCount++ == LOOP_SAMPLE) {
         loopTime = (time - lastTime);
         lastTime = time;
         loopCount = 0;
     }
+    // take one coherent copy of the inputs for this loop //
+    Input_sample();
     // run command scheduler //
     Scheduler_run();
+    LoopStats_mark(LoopPhase_Scheduler);
+}
+
+static void fireEvent(EventType);
+
+static void loopIdle() {
+    // free-running, background work once per loop //
+    if(loopPeriod == 0) {
+        Task_runDue();
+        fireEvent(EventType_Idle);
+        LoopStats_mark(LoopPhase_Events);
+        return;
+    }
+    // paced, background work only gets time the loop left over //
+    if(LogInput(InputChannel_Idle, (long) (Clock_getTicks() - loopDeadline) < 0)) {
+        Task_runDue();
+        fireEvent(EventType_Idle);
+        LoopStats_mark(LoopPhase_Events);
+    }
+    while(!InputLog_isReplaying() && (long) (Clock_getTicks() - loopDeadline) < 0);
+    LoopStats_mark(LoopPhase_Idle);
+    // next period, drop missed periods rather than bursting //
+    loopDeadline += loopPeriod;
+    unsigned long now = Clock_getTicks();
+    if((long) (now - loopDeadline) >= 0) {
+        loopDeadline = now + loopPeriod;
+    }
 }
 
 static void fireEvent(EventType type) {
@@ -93,6 +171,7 @@ static void fireEvent(EventType type) {
 static void executeLoop(RunMode mode) {
     ErrorCode err;
     if(!(err = setjmp(ErrorEvn))) {
+        LogRun(mode);
         bool enabled = true;
         EventType start, periodic, end;
         switch(mode) {
@@ -100,6 +179,8 @@ static void executeLoop(RunMode mode) {
                 // setup Subsystems and hardware //
                 lastRunMode = GlobalData(GLOBALDATA_LAST_RUN_MODE);
                 setRunMode(RunMode_Setup);
+                Clock_initialize();
+                lastTicks = Clock_getTicks();
                 Subsystem_construct();
                 Robot.constructor();
                 Device_configureCortex();
@@ -116,12 +197,16 @@ static void executeLoop(RunMode mode) {
                 break;
             case RunMode_Autonomous:
                 setRunMode(RunMode_Autonomous);
+                CommandGroup_sealAll();
+                Arena_seal();
                 start    = EventType_AutonomousStart;
                 periodic = EventType_AutonomousPeriodic;
                 end      = -1;
                 break;
             case RunMode_Operator:
                 setRunMode(RunMode_Operator);
+                CommandGroup_sealAll();
+                Arena_seal();
                 start    = EventType_OperatorStart;
                 periodic = EventType_OperatorPeriodic;
                 end      = -1;
@@ -133,9 +218,11 @@ static void executeLoop(RunMode mode) {
         // start and execute the loop //
         loopStart();
         fireEvent(start);
-        while(IsEnabled() == enabled) {
+        while(LogInput(InputChannel_Enabled, IsEnabled()) == enabled) {
             loopPeriodic();
             fireEvent(periodic);
+            LoopStats_mark(LoopPhase_Events);
+            loopIdle();
         }
         if(end > -1) fireEvent(end);
     } else {
@@ -163,13 +250,28 @@ RunMode VexOS_getLastRunMode() {
 }
 
 unsigned long VexOS_getRunTime() {
-    return (unsigned long) (lastTime / 1000);
+    return runTimeMs / 1000;
+}
+
+unsigned long VexOS_getRunTimeMs() {
+    return runTimeMs;
+}
+
+unsigned long VexOS_getRunTimeMicros() {
+    return runTimeMicros;
 }
 
 float VexOS_getLoopFrequency() {
     return (1000.0 * LOOP_SAMPLE / loopTime);
 }
 
+void VexOS_setLoopFrequency(unsigned int hz) {
+    ErrorIf(hz > MAX_LOOP_FREQUENCY, VEXOS_ARGRANGE);
+    
+    loopPeriod   = (hz > 0)? (Clock_getTicksPerMicro() * 1000000UL) / hz: 0;
+    loopDeadline = Clock_getTicks() + loopPeriod;
+}
+
 String VexOS_getProgramName() {
     return programName;
 }
@@ -179,7 +281,7 @@ void VexOS_setProgramName(String name) {
 }
 
 bool VexOS_addEventHandler(EventType type, EventHandler* handler, void* state) {
-    ErrorMsgIf(type < EventType_Initialize || type > EventType_SystemError,
+    ErrorMsgIf(type < EventType_Initialize || type > EventType_Idle,
                VEXOS_ARGRANGE, "Invalid EventType");
     ErrorIf(handler == NULL, VEXOS_ARGNULL);
 
@@ -198,7 +300,7 @@ bool VexOS_addEventHandler(EventType type, EventHandler* handler, void* state) {
 }
 
 bool VexOS_removeEventHandler(EventType type, EventHandler* handler) {
-    ErrorMsgIf(type < EventType_Initialize || type > EventType_SystemError,
+    ErrorMsgIf(type < EventType_Initialize || type > EventType_Idle,
                VEXOS_ARGRANGE, "Invalid EventType");
     ErrorIf(handler == NULL, VEXOS_ARGNULL);
     
@@ -217,7 +319,7 @@ bool VexOS_removeEventHandler(EventType type, EventHandler* handler) {
 }
 
 bool VexOS_hasEventHandler(EventType type, EventHandler* handler) {
-    ErrorMsgIf(type < EventType_Initialize || type > EventType_SystemError,
+    ErrorMsgIf(type < EventType_Initialize || type > EventType_Idle,
                VEXOS_ARGRANGE, "Invalid EventType");
     ErrorIf(handler == NULL, VEXOS_ARGNULL);
     
@@ -245,6 +347,8 @@ void VexOS_setupStandardUI() {
     Dashboard_addWindowWithPosition(hdwDash, Device_getWindow(DeviceWindowType_Analog),   0, 16);
     Dashboard_addWindowWithPosition(hdwDash, Device_getWindow(DeviceWindowType_PWM),     34,  0);
     Dashboard_addWindowWithPosition(hdwDash, Device_getWindow(DeviceWindowType_UART),    34, 14);
+    Dashboard* timeDash = Dashboard_new("Timing");
+    Dashboard_addWindowWithPosition(timeDash, LoopStats_getWindow(), 0, 0);
     Dashboard_restoreLast();
     
     LCD* lcd = (LCD*) Device_getByType(DeviceType_LCD);
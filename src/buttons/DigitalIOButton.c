@@ -33,21 +33,22 @@
 #include "API.h"
 
 #include "ButtonClass.h"
+#include "Input.h"
 #include "Hardware.h"
 
 /********************************************************************
  * Class Definition                                                 *
  ********************************************************************/
 
-DefineButtonClass(DigitalIOButton, {
+DefineReentrantButtonClass(DigitalIOButton, {
     DigitalPort port;
 });
 
-static void constructor(va_list argp) {
+static void constructor(Button* self, va_list argp) {
     self->fields->port = va_arg(argp, int);
-    setArgs("%d", self->fields->port);
+    setArgs(self, "%d", self->fields->port);
 }
 
-static bool get() {
-    return !GetDigitalInput(self->fields->port);
+static bool get(Button* self) {
+    return !Input_getDigital(self->fields->port);
 }
@@ -37,15 +37,15 @@
  * Class Definition                                                 *
  ********************************************************************/
 
-DefineButtonClass(InternalButton, {
+DefineReentrantButtonClass(InternalButton, {
     bool state;
 });
 
-static void constructor(va_list argp) {
+static void constructor(Button* self, va_list argp) {
     self->fields->state = false;
 }
 
-static bool get() {
+static bool get(Button* self) {
     return self->fields->state;
 }
 
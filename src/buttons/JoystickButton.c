@@ -33,25 +33,26 @@
 #include "API.h"
 
 #include "ButtonClass.h"
+#include "Input.h"
 
 /********************************************************************
  * Class Definition                                                 *
  ********************************************************************/
 
-DefineButtonClass(JoystickButton, {
+DefineReentrantButtonClass(JoystickButton, {
     unsigned char joystick;
     unsigned char channel;
     unsigned char button;
 });
 
-static void constructor(va_list argp) {
+static void constructor(Button* self, va_list argp) {
     self->fields->joystick = va_arg(argp, unsigned int);
     self->fields->channel  = va_arg(argp, int);
     self->fields->button   = va_arg(argp, int);
-    setArgs("%d, %d, %d", self->fields->joystick, self->fields->channel, self->fields->button);
+    setArgs(self, "%d, %d, %d", self->fields->joystick, self->fields->channel, self->fields->button);
 }
 
-static bool get() {
+static bool get(Button* self) {
     Fields* fields = self->fields;
-    return GetJoystickDigital(fields->joystick, fields->channel, fields->button);
+    return Input_getJoystickDigital(fields->joystick, fields->channel, fields->button);
 }
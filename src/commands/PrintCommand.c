@@ -37,25 +37,25 @@
  * Class Definition                                                 *
  ********************************************************************/
 
-DefineCommandClass(PrintCommand, {
+DefineReentrantCommandClass(PrintCommand, {
     String msg;
 });
 
-static void constructor(va_list argp) {
+static void constructor(Command* self, va_list argp) {
     self->fields->msg = va_arg(argp, String);
-    setArgs("\"%s\"", self->fields->msg);
+    setArgs(self, "\"%s\"", self->fields->msg);
 }
 
-static void initialize() {
+static void initialize(Command* self) {
     Info("%s\n", self->fields->msg);
 }
 
-static void execute() { }
+static void execute(Command* self) { }
 
-static bool isFinished() {
+static bool isFinished(Command* self) {
     return true;
 }
 
-static void end() { }
+static void end(Command* self) { }
 
-static void interrupted() { }
+static void interrupted(Command* self) { }
@@ -36,25 +36,25 @@
  * Class Definition                                                 *
  ********************************************************************/
 
-DefineCommandClass(StartCommand, {
+DefineReentrantCommandClass(StartCommand, {
     Command* command;
 });
 
-static void constructor(va_list argp) {
+static void constructor(Command* self, va_list argp) {
     self->fields->command = va_arg(argp, Command*);
-    setArgs("%s", Command_getName(self->fields->command));
+    setArgs(self, "%@", self->fields->command);
 }
 
-static void initialize(Command* cmd) {
+static void initialize(Command* self) {
     Command_start(self->fields->command);
 }
 
-static void execute() { }
+static void execute(Command* self) { }
 
-static bool isFinished() {
+static bool isFinished(Command* self) {
     return true;
 }
 
-static void end() { }
+static void end(Command* self) { }
 
-static void interrupted() { }
+static void interrupted(Command* self) { }
@@ -46,7 +46,7 @@ DefineCommandClass(UniDriveWithJoystick, {
 static void constructor(va_list argp) {
     self->fields->stick = va_arg(argp, Joystick*);
     ErrorIf(self->fields->stick, VEXOS_ARGNULL);
-    setArgs("%s", Joystick_getId(self->fields->stick));
+    setArgs("%d", Joystick_getId(self->fields->stick));
     require(&UniDrive);
 }
 
@@ -36,22 +36,24 @@
  * Class Definition                                                 *
  ********************************************************************/
 
-DefineCommandClass(WaitCommand, { });
+DefineReentrantCommandClass(WaitCommand, { });
 
-static void constructor(va_list argp) {
+static void constructor(Command* self, va_list argp) {
     float timeout = (float) va_arg(argp, double);
-    setTimeout(timeout * 1000);
-    setArgs("%f", timeout);
+    setTimeout(self, timeout);
+    setArgs(self, "%f", timeout);
 }
 
-static void initialize() { }
+static void initialize(Command* self) {
+    sleepUntilTimedOut(self);
+}
 
-static void execute() { }
+static void execute(Command* self) { }
 
-static bool isFinished() {
+static bool isFinished(Command* self) {
     return Command_isTimedOut(self);
 }
 
-static void end() { }
+static void end(Command* self) { }
 
-static void interrupted() { }
+static void interrupted(Command* self) { }
@@ -37,21 +37,20 @@
  * Class Definition                                                 *
  ********************************************************************/
 
-DefineCommandClass(WaitForChildren, { });
+DefineReentrantCommandClass(WaitForChildren, { });
 
-static void constructor(va_list argp) { }
+static void constructor(Command* self, va_list argp) { }
 
-static void initialize() { }
+static void initialize(Command* self) { }
 
-static void execute() { }
+static void execute(Command* self) { }
 
-static bool isFinished() {
+static bool isFinished(Command* self) {
     Command* parent = Command_getParent(self);
     if(!parent || !CommandGroup_isGroup(parent)) return true;
-    const List* children = CommandGroup_getChildList(parent);
-    return (children->nodeCount == 0);
+    return (CommandGroup_getChildCount(parent) == 0);
 }
 
-static void end() { }
+static void end(Command* self) { }
 
-static void interrupted() { }
+static void interrupted(Command* self) { }
@@ -36,23 +36,26 @@
  * Class Definition                                                 *
  ********************************************************************/
 
-DefineCommandClass(WaitUntilCommand, {
-    float gameTime;
+DefineReentrantCommandClass(WaitUntilCommand, {
+    unsigned long gameTimeMs;
 });
 
-static void constructor(va_list argp) {
-    self->fields->gameTime = (float) va_arg(argp, double);
-    setArgs("%f", self->fields->gameTime);
+static void constructor(Command* self, va_list argp) {
+    float gameTime = (float) va_arg(argp, double);
+    self->fields->gameTimeMs = (unsigned long) (gameTime * 1000);
+    setArgs(self, "%f", gameTime);
 }
 
-static void initialize() { }
+static void initialize(Command* self) {
+    sleepUntil(self, self->fields->gameTimeMs);
+}
 
-static void execute() { }
+static void execute(Command* self) { }
 
-static bool isFinished(Command* cmd) {
-    return (VexOS_getRunTime() >= self->fields->gameTime);
+static bool isFinished(Command* self) {
+    return (VexOS_getRunTimeMs() >= self->fields->gameTimeMs);
 }
 
-static void end() { }
+static void end(Command* self) { }
 
-static void interrupted() { }
+static void interrupted(Command* self) { }
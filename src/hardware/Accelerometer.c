@@ -23,6 +23,7 @@
 
 #include "Hardware.h"
 #include "Device.h"
+#include "InputLog.h"
 #include "Error.h"
 
 /********************************************************************
@@ -88,6 +89,6 @@ void Accelerometer_setEnabled(Accelerometer* accel, bool value) {
 float Accelerometer_getAccelerationG(Accelerometer* accel) {
     ErrorIf(accel == NULL, VEXOS_ARGNULL);
 
-    return GetGyroAngle(accel->port) / 1000.0;
+    return LogInput(InputChannel_Gyro + accel->port - 1, GetGyroAngle(accel->port)) / 1000.0;
 }
 
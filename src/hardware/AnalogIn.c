@@ -23,6 +23,8 @@
 
 #include "Hardware.h"
 #include "Device.h"
+#include "Input.h"
+#include "InputLog.h"
 #include "Error.h"
 
 /********************************************************************
@@ -56,6 +58,15 @@ static AnalogIn* new(String name, DeviceType type, AnalogPort port) {
     return ret;
 }
 
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+float AnalogIn_read(AnalogIn* in) {
+    long raw = LogInput(InputChannel_AnalogHR + in->port - 1, GetAnalogInputHR(in->port));
+    return (((int) raw) - in->offset) * in->scale;
+}
+
 /********************************************************************
  * Public API                                                       *
  ********************************************************************/
@@ -106,24 +117,24 @@ void AnalogIn_setScaleFactor(AnalogIn* in, float scale) {
 int AnalogIn_getRaw(AnalogIn* in) {
     ErrorIf(in == NULL, VEXOS_ARGNULL);
     
-    return GetAnalogInputHR(in->port);
+    return Input_getAnalog(in->port);
 }
 
 void AnalogIn_presetRaw(AnalogIn* in, int value) {
     ErrorIf(in == NULL, VEXOS_ARGNULL);
 
-    in->offset = GetAnalogInputHR(in->port) - value;
+    in->offset = Input_getAnalog(in->port) - value;
 }
 
 float AnalogIn_get(AnalogIn* in) {
     ErrorIf(in == NULL, VEXOS_ARGNULL);
 
-    return (((int) GetAnalogInputHR(in->port)) - in->offset) * in->scale;
+    return (((int) Input_getAnalog(in->port)) - in->offset) * in->scale;
 }
 
 void AnalogIn_preset(AnalogIn* in, float value) {
     ErrorIf(in == NULL, VEXOS_ARGNULL);
 
-    in->offset = GetAnalogInputHR(in->port) - (int)(value / in->scale);
+    in->offset = Input_getAnalog(in->port) - (int)(value / in->scale);
 }
 
@@ -23,6 +23,8 @@
 
 #include "Hardware.h"
 #include "Device.h"
+#include "Input.h"
+#include "InputLog.h"
 #include "Error.h"
 
 /********************************************************************
@@ -56,6 +58,14 @@ static DigitalIn* new(String name, DeviceType type, DigitalPort port) {
     return ret;
 }
 
+/********************************************************************
+ * Protected API                                                    *
+ ********************************************************************/
+
+bool DigitalIn_read(DigitalIn* in) {
+    return LogInput(InputChannel_Digital + in->port - 1, GetDigitalInput(in->port)) ^ in->inverted;
+}
+
 /********************************************************************
  * Public API                                                       *
  ********************************************************************/
@@ -112,7 +122,7 @@ void DigitalIn_setInverted(DigitalIn* in, bool value) {
 bool DigitalIn_get(DigitalIn* in) {
     ErrorIf(in == NULL, VEXOS_ARGNULL);
 
-    return GetDigitalInput(in->port) ^ in->inverted;
+    return Input_getDigital(in->port) ^ in->inverted;
 }
 
 InterruptMode DigitalIn_getInterruptMode(DigitalIn* in) {
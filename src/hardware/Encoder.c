@@ -23,6 +23,7 @@
 
 #include "Hardware.h"
 #include "Device.h"
+#include "InputLog.h"
 #include "Error.h"
 
 /********************************************************************
@@ -148,9 +149,10 @@ long Encoder_getRaw(Encoder* encoder) {
 
     switch(encoder->type) {
         case DeviceType_QuadratureEncoder:
-            return GetQuadEncoder(encoder->portA, encoder->portB);
+            return LogInput(InputChannel_Encoder + encoder->portA - 1,
+                            GetQuadEncoder(encoder->portA, encoder->portB));
         case DeviceType_Encoder:
-            return GetEncoder(encoder->portA);
+            return LogInput(InputChannel_Encoder + encoder->portA - 1, GetEncoder(encoder->portA));
         default: 
             return 0;
     }
@@ -177,9 +179,11 @@ float Encoder_get(Encoder* encoder) {
 
     switch(encoder->type) {
         case DeviceType_QuadratureEncoder:
-            return GetQuadEncoder(encoder->portA, encoder->portB) * encoder->scale;
+            return LogInput(InputChannel_Encoder + encoder->portA - 1,
+                            GetQuadEncoder(encoder->portA, encoder->portB)) * encoder->scale;
         case DeviceType_Encoder:
-            return GetEncoder(encoder->portA) * encoder->scale;
+            return LogInput(InputChannel_Encoder + encoder->portA - 1,
+                            GetEncoder(encoder->portA)) * encoder->scale;
         default: 
             return 0.0;
     }
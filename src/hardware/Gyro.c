@@ -23,6 +23,7 @@
 
 #include "Hardware.h"
 #include "Device.h"
+#include "InputLog.h"
 #include "Error.h"
 
 /********************************************************************
@@ -107,5 +108,5 @@ void Gyro_setDeadband(Gyro* gyro, int value) {
 float Gyro_getAngleDegrees(Gyro* gyro) {
     ErrorIf(gyro == NULL, VEXOS_ARGNULL);
 
-    return GetGyroAngle(gyro->port) / 10.0;
+    return LogInput(InputChannel_Gyro + gyro->port - 1, GetGyroAngle(gyro->port)) / 10.0;
 }
@@ -25,6 +25,7 @@
 #include "Device.h"
 #include "MotorGroup.h"
 #include "Interrupt.h"
+#include "InputLog.h"
 #include "Error.h"
 
 /********************************************************************
@@ -46,123 +47,229 @@ static bool    initialized;
 static char    imeWatch;
 static ImeData imeData[MAX_IME];
 
-// called before group interrupts //
-static void imeInterrupt(void* object) {
-    if(!imeWatch) return;
-    GetIntegratedMotorEncodersData(imeData);
+// control state of every group, one array per field indexed by the  //
+// group's slot, so each stage of the ISR walks contiguous memory     //
+static struct {
+    unsigned short   count;
+    unsigned short   capacity;
+    MotorGroup**     group;
+    // feedback //
+    bool*            feedbackEnabled;
+    FeedbackType*    feedbackType;
+    Device**         feedbackDevice;
+    unsigned char*   ime;               // index into imeData //
+    bool*            imeReversed;       // IME counts backwards //
+    float*           feedbackScale;
+    volatile float*  position;
+    float*           lastPosition;
+    volatile float*  speed;
+    signed char*     speedCycle;
+    SpeedHandler**   speedHandler;
+    unsigned char*   globaldataSlot;
+    // closed loop //
+    bool*            pidEnabled;
+    PIDState*        pid;
+    // open loop power //
+    Power*           powerRequested;
+    volatile Power*  powerActual;
+    Power*           powerSlewRate;
+    DigitalIn**      limitSwitchRev;
+    DigitalIn**      limitSwitchFwd;
+    unsigned short*  motorFirst;
+    unsigned short*  motorCount;
+    // motors of every group, each group's are contiguous, in slot order //
+    unsigned short   motors;
+    unsigned short   motorCapacity;
+    PWMPort*         motorPort;
+    bool*            motorReversed;
+} control;
+
+static void* growArray(void* array, size_t size, unsigned short capacity) {
+    void* ret = realloc(array, size * capacity);
+    ErrorIf(ret == NULL, VEXOS_NOMEMORY);
+    return ret;
 }
 
-// called for each group //
-static void groupInterrupt(void* object) {
-    MotorGroup* group = object;
+#define GrowArray(array, capacity) \
+    array = growArray((void*) array, sizeof(*(array)), capacity)
+
+static void growGroups() {
+    unsigned short capacity = (control.capacity)? control.capacity * 2: 4;
+    GrowArray(control.group,           capacity);
+    GrowArray(control.feedbackEnabled, capacity);
+    GrowArray(control.feedbackType,    capacity);
+    GrowArray(control.feedbackDevice,  capacity);
+    GrowArray(control.ime,             capacity);
+    GrowArray(control.imeReversed,     capacity);
+    GrowArray(control.feedbackScale,   capacity);
+    GrowArray(control.position,        capacity);
+    GrowArray(control.lastPosition,    capacity);
+    GrowArray(control.speed,           capacity);
+    GrowArray(control.speedCycle,      capacity);
+    GrowArray(control.speedHandler,    capacity);
+    GrowArray(control.globaldataSlot,  capacity);
+    GrowArray(control.pidEnabled,      capacity);
+    GrowArray(control.pid,             capacity);
+    GrowArray(control.powerRequested,  capacity);
+    GrowArray(control.powerActual,     capacity);
+    GrowArray(control.powerSlewRate,   capacity);
+    GrowArray(control.limitSwitchRev,  capacity);
+    GrowArray(control.limitSwitchFwd,  capacity);
+    GrowArray(control.motorFirst,      capacity);
+    GrowArray(control.motorCount,      capacity);
+    control.capacity = capacity;
+}
+
+// the arrays may move, keep the ISR out while they do //
+static void insertMotor(unsigned short slot, bool first, PWMPort port, bool reversed) {
+    bool lastEnabled = Interrupt_isEnabled();
+    Interrupt_disable();
+
+    if(control.motors == control.motorCapacity) {
+        unsigned short capacity = (control.motorCapacity)? control.motorCapacity * 2: 8;
+        GrowArray(control.motorPort,     capacity);
+        GrowArray(control.motorReversed, capacity);
+        control.motorCapacity = capacity;
+    }
+    unsigned short at = control.motorFirst[slot] + ((first)? 0: control.motorCount[slot]);
+    unsigned short i;
+    for(i = control.motors; i > at; i--) {
+        control.motorPort[i]     = control.motorPort[i - 1];
+        control.motorReversed[i] = control.motorReversed[i - 1];
+    }
+    control.motorPort[at]     = port;
+    control.motorReversed[at] = reversed;
+    control.motors++;
+    control.motorCount[slot]++;
+    // the groups after this one moved up //
+    for(i = slot + 1; i < control.count; i++) {
+        control.motorFirst[i]++;
+    }
 
-    // make sure we process feedback //
-    if(!group->feedbackEnabled) goto handle_power;
+    if(lastEnabled) Interrupt_enable();
+}
 
-    // get the current position //
-    Device* device = group->feedbackDevice;
-    Motor*  motor  = NULL;
+static void readFeedback(unsigned short i) {
+    float input = control.pid[i].input;
     long imeTicks;
     GlobalDataValue gdata;
     gdata.ulongValue = 0;
-    switch(group->feedbackType) {
+    switch(control.feedbackType[i]) {
         case FeedbackType_IME:
             // get the position //
-            motor    = (Motor*) device;
-            imeTicks = imeData[motor->i2c - 1].counter;
-            gdata.floatValue = imeTicks * group->feedbackScale;
-            if(motor->reversed ^ (motor->motorType == MotorType_269)) {
-                gdata.floatValue = -gdata.floatValue;
-            }
-            group->pid.input = gdata.floatValue;
+            imeTicks = imeData[control.ime[i]].counter;
+            input    = imeTicks * control.feedbackScale[i];
+            if(control.imeReversed[i]) input = -input;
             gdata.ulongValue = imeTicks;
             break;
         case FeedbackType_Encoder:
-            gdata.floatValue = Encoder_get((Encoder*) group->feedbackDevice);
-            group->pid.input = gdata.floatValue * group->feedbackScale;
+            gdata.floatValue = Encoder_get((Encoder*) control.feedbackDevice[i]);
+            input = gdata.floatValue * control.feedbackScale[i];
             break;
         case FeedbackType_Potentiometer:
-            gdata.floatValue = AnalogIn_get((AnalogIn*) group->feedbackDevice);
-            group->pid.input = gdata.floatValue * group->feedbackScale;
+            gdata.floatValue = AnalogIn_read((AnalogIn*) control.feedbackDevice[i]);
+            input = gdata.floatValue * control.feedbackScale[i];
             break;
         default: break;
     }
-    GlobalData(group->globaldataSlot) = gdata.ulongValue;
-    // we computed with pid.input because it was non-volatile //
-    // this is more efficient, we know volatile things won't  //
-    // change in the ISR, but the compiler doesn't know that  //
-    group->position = group->pid.input;
-   
+    GlobalData(control.globaldataSlot[i]) = gdata.ulongValue;
+    control.pid[i].input = input;
+    control.position[i]  = input;
+
     // compute speed every 5 cycles (100ms), avoid glitch during startup // 
-    group->speedCycle--;
-    if(group->speedCycle <= 0) {
+    control.speedCycle[i]--;
+    if(control.speedCycle[i] <= 0) {
         // this is a valid countdown, compute based on feedback type //
-        if(group->speedCycle == 0) {
-            if(group->feedbackType == FeedbackType_IME) {
+        if(control.speedCycle[i] == 0) {
+            if(control.feedbackType[i] == FeedbackType_IME) {
                 // IME use the built-in period value to determine speed //
-                int xspeed = imeData[motor->i2c - 1].speed;
-                if((xspeed != 0) && (group->pid.input != group->lastPosition)) {
-                    if(group->pid.input < group->lastPosition) xspeed = -xspeed;
+                int xspeed = imeData[control.ime[i]].speed;
+                if((xspeed != 0) && (input != control.lastPosition[i])) {
+                    if(input < control.lastPosition[i]) xspeed = -xspeed;
                     // reversed engineered speed conversion formal //
-                    group->speed = (125440.0 * group->feedbackScale / xspeed);
+                    control.speed[i] = (125440.0 * control.feedbackScale[i] / xspeed);
                 } else {
-                    group->speed = 0.0;
+                    control.speed[i] = 0.0;
                 }
             } else {
                 // other cases use delta in position over time //
-                group->speed = (group->pid.input - group->lastPosition) 
-                                / (SPEED_COMPUTE_CYCLES * INTERRUPT_PERIOD_SECONDS);
+                control.speed[i] = (input - control.lastPosition[i])
+                                   / (SPEED_COMPUTE_CYCLES * INTERRUPT_PERIOD_SECONDS);
             }
-            if(group->speedHandler) group->speedHandler(group);
+            if(control.speedHandler[i]) control.speedHandler[i](control.group[i]);
         }
-        group->lastPosition = group->pid.input;
-        group->speedCycle   = (group->speedCycle == -1)? 1: SPEED_COMPUTE_CYCLES;
+        control.lastPosition[i] = input;
+        control.speedCycle[i]   = (control.speedCycle[i] == -1)? 1: SPEED_COMPUTE_CYCLES;
     }
+}
 
-    // run the PID loop, if PID is enabled //
-    if(group->pidEnabled) {
-        PID_calculate(&group->pid);
-        group->powerRequested = group->pid.output;
-    }
+static void updatePower(unsigned short i) {
+    Power requested = control.powerRequested[i];
+    Power actual    = control.powerActual[i];
 
-    // update the motors with open-loop functions //
-handle_power:
     // handle limit switches //
-    if(  (group->powerRequested < 0 && group->limitSwitchRev && DigitalIn_get(group->limitSwitchRev)) 
-      || (group->powerRequested > 0 && group->limitSwitchFwd && DigitalIn_get(group->limitSwitchFwd))) 
+    DigitalIn* limitRev = control.limitSwitchRev[i];
+    DigitalIn* limitFwd = control.limitSwitchFwd[i];
+    if(  (requested < 0 && limitRev && DigitalIn_read(limitRev))
+      || (requested > 0 && limitFwd && DigitalIn_read(limitFwd)))
     {
-        group->powerActual = 0;
+        actual = 0;
     } else {
         // check if there is something to do //
-        if(group->powerActual == group->powerRequested) return;
+        if(actual == requested) return;
 
         // handle slewing //
-        if(group->powerRequested > group->powerActual) {
-            group->powerActual += group->powerSlewRate;
-            if(group->powerActual > group->powerRequested) {
-                group->powerActual = group->powerRequested;
-            }
+        if(requested > actual) {
+            actual += control.powerSlewRate[i];
+            if(actual > requested) actual = requested;
         } else {
-            group->powerActual -= group->powerSlewRate;
-            if(group->powerActual < group->powerRequested) {
-                group->powerActual = group->powerRequested;
-            }
+            actual -= control.powerSlewRate[i];
+            if(actual < requested) actual = requested;
         }
     }
+    control.powerActual[i] = actual;
 
     // update the motors //
-    ListNode* mnode = group->children.firstNode;
-    while(mnode) {
-        motor = mnode->data;
-        float mpower = (motor->reversed)? -group->powerActual: group->powerActual; 
-        SetMotor(motor->port, mpower * MAX_MOTOR_POWER); 
-        mnode = mnode->next;
+    unsigned short m   = control.motorFirst[i];
+    unsigned short end = m + control.motorCount[i];
+    for(; m < end; m++) {
+        float mpower = (control.motorReversed[m])? -actual: actual;
+        SetMotor(control.motorPort[m], mpower * MAX_MOTOR_POWER);
+    }
+}
+
+// one handler runs every group, a stage at a time //
+static void controlInterrupt(void* object) {
+    unsigned short count = control.count;
+    unsigned short i;
+
+    if(imeWatch) {
+        GetIntegratedMotorEncodersData(imeData);
+#ifdef INPUTLOG
+        for(i = 0; i < MAX_IME; i++) {
+            imeData[i].counter = LogInput(InputChannel_ImeCounter + i, imeData[i].counter);
+            imeData[i].speed   = LogInput(InputChannel_ImeSpeed + i, imeData[i].speed);
+        }
+#endif
+    }
+    for(i = 0; i < count; i++) {
+        if(control.feedbackEnabled[i]) readFeedback(i);
+    }
+    // run the PID loops, where enabled //
+    for(i = 0; i < count; i++) {
+        if(control.feedbackEnabled[i] && control.pidEnabled[i]) {
+            PID_calculate(&control.pid[i]);
+            control.powerRequested[i] = control.pid[i].output;
+        }
+    }
+    for(i = 0; i < count; i++) {
+        updatePower(i);
     }
 }
 
 static void initialize() {
-    // register the IME watcher //
-    Interrupt_add(NULL, &imeInterrupt, 1, 5);
+    // register the control handler for every group //
+    Interrupt_add(NULL, &controlInterrupt, "MotorGroup", 1, 10);
     initialized = true;
 }
 
@@ -171,11 +278,11 @@ static void initialize() {
  ********************************************************************/
 
 SpeedHandler* MotorGroup_getSpeedHandler(MotorGroup* group) {
-    return group->speedHandler;
+    return control.speedHandler[group->slot];
 }
 
 void MotorGroup_setSpeedHandler(MotorGroup* group, SpeedHandler* handler) {
-    group->speedHandler = handler;
+    control.speedHandler[group->slot] = handler;
 }
 
 /********************************************************************
@@ -189,34 +296,46 @@ MotorGroup* MotorGroup_new(String name) {
     ret->type             = DeviceType_MotorGroup;
     ret->name             = name;
     memset(&ret->children, 0, sizeof(List));
-    ret->powerActual      = 0.0;
-    ret->powerRequested   = 0.0;
     ret->powerDeadbandMin = 0.0;
     ret->powerDeadbandMax = 0.0;
-    ret->powerSlewRate    = 2.0; // disabled: slew entire range in one cycle //
     ret->outputScale      = 1.0;
-    ret->feedbackEnabled  = false;
-    ret->feedbackType     = FeedbackType_None;
-    ret->feedbackDevice   = NULL;
-    ret->feedbackScale    = 1.0;
-    ret->limitSwitchRev   = NULL;
-    ret->limitSwitchFwd   = NULL;
-    ret->position         = 0.0;
-    ret->lastPosition     = 0.0;
-    ret->speed            = 0.0;
-    ret->speedCycle       = 0;  // forces a startup //
-    ret->speedHandler     = NULL;
-    ret->pidEnabled       = false;
-    PID_initialize(&ret->pid);
     ret->pidTolerance     = (10.0 / 360); // motor within 10 degrees //
-    ret->globaldataSlot   = 0;
-    Device_addVirtualDevice((Device*) ret);
 
     // initialization //
     if(!initialized) initialize();
-    
-    // add a group-specific ISR //
-    Interrupt_add(ret, &groupInterrupt, 1, 10);
+
+    // claim a control slot, the arrays may move //
+    bool lastEnabled = Interrupt_isEnabled();
+    Interrupt_disable();
+    if(control.count == control.capacity) growGroups();
+    unsigned short i = control.count;
+    ret->slot                  = i;
+    control.group[i]           = ret;
+    control.feedbackEnabled[i] = false;
+    control.feedbackType[i]    = FeedbackType_None;
+    control.feedbackDevice[i]  = NULL;
+    control.ime[i]             = 0;
+    control.imeReversed[i]     = false;
+    control.feedbackScale[i]   = 1.0;
+    control.position[i]        = 0.0;
+    control.lastPosition[i]    = 0.0;
+    control.speed[i]           = 0.0;
+    control.speedCycle[i]      = 0;  // forces a startup //
+    control.speedHandler[i]    = NULL;
+    control.globaldataSlot[i]  = 0;
+    control.pidEnabled[i]      = false;
+    PID_initialize(&control.pid[i]);
+    control.powerRequested[i]  = 0.0;
+    control.powerActual[i]     = 0.0;
+    control.powerSlewRate[i]   = 2.0; // disabled: slew entire range in one cycle //
+    control.limitSwitchRev[i]  = NULL;
+    control.limitSwitchFwd[i]  = NULL;
+    control.motorFirst[i]      = control.motors;
+    control.motorCount[i]      = 0;
+    control.count++;
+    if(lastEnabled) Interrupt_enable();
+
+    Device_addVirtualDevice((Device*) ret);
     return ret;
 }
 
@@ -225,6 +344,7 @@ void MotorGroup_add(MotorGroup* group, String name, PWMPort port, MotorType type
 
     Motor* motor = Motor_new(group, name, port, type, reversed, 0);
     List_insertLast(&group->children, List_newNode(motor));
+    insertMotor(group->slot, false, port, reversed);
 }
 
 void MotorGroup_addWithIME(MotorGroup* group, String name, PWMPort port, MotorType type, 
@@ -240,16 +360,20 @@ void MotorGroup_addWithIME(MotorGroup* group, String name, PWMPort port, MotorTy
     // add motor at start of the list //
     Motor* motor = Motor_new(group, name, port, type, reversed, i2c);
     List_insertFirst(&group->children, List_newNode(motor));
-    group->feedbackType   = FeedbackType_IME;
-    group->feedbackDevice = (Device*) motor;
+    insertMotor(group->slot, true, port, reversed);
+    unsigned short i = group->slot;
+    control.feedbackType[i]   = FeedbackType_IME;
+    control.feedbackDevice[i] = (Device*) motor;
+    control.ime[i]            = i2c - 1;
+    control.imeReversed[i]    = reversed ^ (type == MotorType_269);
     // set feedback ratio based on IME type //
     switch(type) {
-        case MotorType_269:    group->feedbackScale = (1.0 / TicksPerRev_IME_269);   break;
-        case MotorType_393_HT: group->feedbackScale = (1.0 / TicksPerRev_IME_393HT); break;
-        case MotorType_393_HS: group->feedbackScale = (1.0 / TicksPerRev_IME_393HS); break;
+        case MotorType_269:    control.feedbackScale[i] = (1.0 / TicksPerRev_IME_269);   break;
+        case MotorType_393_HT: control.feedbackScale[i] = (1.0 / TicksPerRev_IME_393HT); break;
+        case MotorType_393_HS: control.feedbackScale[i] = (1.0 / TicksPerRev_IME_393HS); break;
         default: break;
     }
-    group->globaldataSlot = nextGlobalDataSlot--;
+    control.globaldataSlot[i] = nextGlobalDataSlot--;
 }
 
 const List* MotorGroup_getMotorList(MotorGroup* group) {
@@ -263,29 +387,30 @@ const List* MotorGroup_getMotorList(MotorGroup* group) {
 Power MotorGroup_getPower(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->powerRequested;
+    return control.powerRequested[group->slot];
 }
 
 Power MotorGroup_getActualPower(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->powerActual;
+    return control.powerActual[group->slot];
 }
 
 void MotorGroup_setPower(MotorGroup* group, Power power) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
-    if(group->powerRequested == power) return;
+    unsigned short i = group->slot;
+    if(control.powerRequested[i] == power) return;
 
     // disable PID if manual power setting is used //
-    if(group->pidEnabled) {
+    if(control.pidEnabled[i]) {
         MotorGroup_setPIDEnabled(group, false);
     }
 
     // clip to range //
-    if(power < group->pid.minOut) {
-        power = group->pid.minOut;
-    } else if(power > group->pid.maxOut) {
-        power = group->pid.maxOut;
+    if(power < control.pid[i].minOut) {
+        power = control.pid[i].minOut;
+    } else if(power > control.pid[i].maxOut) {
+        power = control.pid[i].maxOut;
     }
 
     // handle deadband //
@@ -297,22 +422,22 @@ void MotorGroup_setPower(MotorGroup* group, Power power) {
     }
 
     // request the power, is set in the ISR //
-    group->powerRequested = power;
+    control.powerRequested[i] = power;
 }
 
 void MotorGroup_getPowerRange(MotorGroup* group, Power* min, Power* max) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    if(min) *min = group->pid.minOut;
-    if(max) *max = group->pid.maxOut;
+    if(min) *min = control.pid[group->slot].minOut;
+    if(max) *max = control.pid[group->slot].maxOut;
 }
 
 void MotorGroup_setPowerRange(MotorGroup* group, Power min, Power max) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
     ErrorMsgIf(min > max, VEXOS_ARGINVALID, "Lower bound is greater than upper bound");
 
-    group->pid.minOut = min;
-    group->pid.maxOut = max;
+    control.pid[group->slot].minOut = min;
+    control.pid[group->slot].maxOut = max;
 }
 
 void MotorGroup_getDeadband(MotorGroup* group, Power* min, Power* max) {
@@ -333,7 +458,8 @@ void MotorGroup_setDeadband(MotorGroup* group, Power min, Power max) {
 Power MotorGroup_getSlewTime(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return (group->powerSlewRate >= 2.0)? 0: group->powerSlewRate;
+    Power rate = control.powerSlewRate[group->slot];
+    return (rate >= 2.0)? 0: rate;
 }
 
 void MotorGroup_setSlewTime(MotorGroup* group, float time) {
@@ -341,48 +467,50 @@ void MotorGroup_setSlewTime(MotorGroup* group, float time) {
     ErrorIf(time < 0, VEXOS_ARGRANGE);
 
     if(time > 0) {
-        group->powerSlewRate = (INTERRUPT_PERIOD_SECONDS / time);
+        control.powerSlewRate[group->slot] = (INTERRUPT_PERIOD_SECONDS / time);
     } else {
         // for slew == 0, this will go full scale in one cycle //
         // which is the fastest we can do anyway with the ISR  //
-        group->powerSlewRate = 2.0;
+        control.powerSlewRate[group->slot] = 2.0;
     }
 }
 
 DigitalIn* MotorGroup_getReverseLimitSwitch(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->limitSwitchRev;
+    return control.limitSwitchRev[group->slot];
 }
 
 void MotorGroup_setReverseLimitSwitch(MotorGroup* group, DigitalIn* input) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    group->limitSwitchRev = input;
+    control.limitSwitchRev[group->slot] = input;
 }
 
 bool MotorGroup_isReverseLimitOK(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return (group->limitSwitchRev)? !DigitalIn_get(group->limitSwitchRev): true;
+    DigitalIn* input = control.limitSwitchRev[group->slot];
+    return (input)? !DigitalIn_get(input): true;
 }
 
 DigitalIn* MotorGroup_getForwardLimitSwitch(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->limitSwitchFwd;
+    return control.limitSwitchFwd[group->slot];
 }
 
 void MotorGroup_setForwardLimitSwitch(MotorGroup* group, DigitalIn* input) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    group->limitSwitchFwd = input;
+    control.limitSwitchFwd[group->slot] = input;
 }
 
 bool MotorGroup_isForwardLimitOK(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return (group->limitSwitchFwd)? !DigitalIn_get(group->limitSwitchFwd): true;
+    DigitalIn* input = control.limitSwitchFwd[group->slot];
+    return (input)? !DigitalIn_get(input): true;
 }
 
 // feedback monitoring //
@@ -392,12 +520,13 @@ void MotorGroup_addEncoder(MotorGroup* group, Encoder* encoder) {
     ErrorIf(encoder == NULL, VEXOS_ARGNULL);
     Device* device = (Device*) encoder;
     ErrorIf(device->type != DeviceType_QuadratureEncoder, VEXOS_ARGINVALID);
-    ErrorMsgIf(group->feedbackType != FeedbackType_None, VEXOS_OPINVALID,
+    unsigned short i = group->slot;
+    ErrorMsgIf(control.feedbackType[i] != FeedbackType_None, VEXOS_OPINVALID,
                "MotorGroup already has a feedback mechanism: %s", group->name);
 
-    group->feedbackType   = FeedbackType_Encoder;
-    group->feedbackDevice = device;
-    group->globaldataSlot = nextGlobalDataSlot--;
+    control.feedbackType[i]   = FeedbackType_Encoder;
+    control.feedbackDevice[i] = device;
+    control.globaldataSlot[i] = nextGlobalDataSlot--;
 }
 
 void MotorGroup_addPotentiometer(MotorGroup* group, AnalogIn* pot) {
@@ -405,58 +534,60 @@ void MotorGroup_addPotentiometer(MotorGroup* group, AnalogIn* pot) {
     ErrorIf(pot == NULL,   VEXOS_ARGNULL);
     Device* device = (Device*) pot;
     ErrorIf(device->type != DeviceType_Potentiometer, VEXOS_ARGINVALID);
-    ErrorMsgIf(group->feedbackType != FeedbackType_None, VEXOS_OPINVALID,
+    unsigned short i = group->slot;
+    ErrorMsgIf(control.feedbackType[i] != FeedbackType_None, VEXOS_OPINVALID,
                "MotorGroup already has a feedback mechanism: %s", group->name);
 
-    group->feedbackType   = FeedbackType_Potentiometer;
-    group->feedbackDevice = device;
-    group->globaldataSlot = nextGlobalDataSlot--;
+    control.feedbackType[i]   = FeedbackType_Potentiometer;
+    control.feedbackDevice[i] = device;
+    control.globaldataSlot[i] = nextGlobalDataSlot--;
     AnalogIn_preset(pot, 0.0);
 }
 
 Device* MotorGroup_getSensor(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->feedbackDevice;
+    return control.feedbackDevice[group->slot];
 }
 
 FeedbackType MotorGroup_getFeedbackType(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->feedbackType;
+    return control.feedbackType[group->slot];
 }
 
 bool MotorGroup_isFeedbackEnabled(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->feedbackEnabled;
+    return control.feedbackEnabled[group->slot];
 }
 
 void MotorGroup_setFeedbackEnabled(MotorGroup* group, bool value) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
-    ErrorMsgIf(group->feedbackType == FeedbackType_None, VEXOS_OPINVALID,
+    unsigned short i = group->slot;
+    ErrorMsgIf(control.feedbackType[i] == FeedbackType_None, VEXOS_OPINVALID,
                "MotorGroup has no feedback mechanism: %s", group->name);
     ErrorIf(VexOS_getRunMode() == RunMode_Setup, VEXOS_NOTINITIALIZED);
 
-    if(group->feedbackEnabled == value) return;
-    group->feedbackEnabled = value;
+    if(control.feedbackEnabled[i] == value) return;
+    control.feedbackEnabled[i] = value;
     if(!value) {
-        if(group->pidEnabled) {
+        if(control.pidEnabled[i]) {
             MotorGroup_setPIDEnabled(group, false);
         }
-        group->position     = 0.0;
-        group->lastPosition = 0.0;
-        group->speed        = 0.0;
+        control.position[i]     = 0.0;
+        control.lastPosition[i] = 0.0;
+        control.speed[i]        = 0.0;
     } else {
         // this forces a start-up condition //
-        group->speedCycle = 0;
+        control.speedCycle[i] = 0;
     }
-    switch(group->feedbackType) {
+    switch(control.feedbackType[i]) {
         case FeedbackType_IME:
             imeWatch += (value)? 1: -1;
             break;
         case FeedbackType_Encoder:
-            Encoder_setEnabled((Encoder*) group->feedbackDevice, value);
+            Encoder_setEnabled((Encoder*) control.feedbackDevice[i], value);
             break;
         case FeedbackType_Potentiometer:
         default: 
@@ -479,37 +610,39 @@ void MotorGroup_setOutputScaleFactor(MotorGroup* group, float scale) {
 float MotorGroup_getFeedbackScaleFactor(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->feedbackScale;
+    return control.feedbackScale[group->slot];
 }
 
 void MotorGroup_setFeedbackScaleFactor(MotorGroup* group, float scale) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
     ErrorIf(scale == 0.0, VEXOS_ARGINVALID);
-    ErrorIf(group->feedbackType == FeedbackType_IME, VEXOS_OPINVALID);
+    ErrorIf(control.feedbackType[group->slot] == FeedbackType_IME, VEXOS_OPINVALID);
 
-    group->feedbackScale = scale;
+    control.feedbackScale[group->slot] = scale;
 }
 
 float MotorGroup_getPosition(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
-    ErrorMsgIf(group->feedbackType == FeedbackType_None, VEXOS_OPINVALID,
+    unsigned short i = group->slot;
+    ErrorMsgIf(control.feedbackType[i] == FeedbackType_None, VEXOS_OPINVALID,
                "MotorGroup has no feedback mechanism: %s", group->name);
     
-    if(!group->feedbackEnabled) return NAN;
-    return group->position * group->outputScale;
+    if(!control.feedbackEnabled[i]) return NAN;
+    return control.position[i] * group->outputScale;
 }
 
 void MotorGroup_presetPosition(MotorGroup* group, float value) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
-    ErrorMsgIf(group->feedbackType == FeedbackType_None, VEXOS_OPINVALID,
+    unsigned short i = group->slot;
+    ErrorMsgIf(control.feedbackType[i] == FeedbackType_None, VEXOS_OPINVALID,
                "MotorGroup has no feedback mechanism: %s", group->name);
 
-    if(!group->feedbackEnabled) return;
-    float sensorPos = (value / (group->outputScale * group->feedbackScale));
+    if(!control.feedbackEnabled[i]) return;
+    float sensorPos = (value / (group->outputScale * control.feedbackScale[i]));
     
-    Device* device = group->feedbackDevice;
+    Device* device = control.feedbackDevice[i];
     Motor* motor;
-    switch(group->feedbackType) {
+    switch(control.feedbackType[i]) {
         case FeedbackType_IME:
             motor = (Motor*) device;
             // preset does NOT invert the value when set, so we need to //
@@ -530,23 +663,25 @@ void MotorGroup_presetPosition(MotorGroup* group, float value) {
             break;
     }
     // force speed recompute so we avoid glitches //
-    group->speedCycle = 0;
+    control.speedCycle[i] = 0;
 }
 
 float MotorGroup_getSpeed(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
     ErrorIf(VexOS_getRunMode() == RunMode_Setup, VEXOS_NOTINITIALIZED);
-    ErrorMsgIf(group->feedbackType == FeedbackType_None, VEXOS_OPINVALID,
+    unsigned short i = group->slot;
+    ErrorMsgIf(control.feedbackType[i] == FeedbackType_None, VEXOS_OPINVALID,
                "MotorGroup has no feedback mechanism: %s", group->name);
 
-    if(!group->feedbackEnabled) return NAN;
-    return group->speed * group->outputScale;
+    if(!control.feedbackEnabled[i]) return NAN;
+    return control.speed[i] * group->outputScale;
 }
 
 void MotorGroup_restorePosition(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
     ErrorIf(VexOS_getRunMode() == RunMode_Setup, VEXOS_NOTINITIALIZED);
-    ErrorMsgIf(group->feedbackType == FeedbackType_None, VEXOS_OPINVALID,
+    unsigned short i = group->slot;
+    ErrorMsgIf(control.feedbackType[i] == FeedbackType_None, VEXOS_OPINVALID,
                "MotorGroup has no feedback mechanism: %s", group->name);
 
     // enable feedback //
@@ -554,10 +689,10 @@ void MotorGroup_restorePosition(MotorGroup* group) {
 
     // look up global data //
     GlobalDataValue gdata;
-    gdata.ulongValue = GlobalData(group->globaldataSlot);
+    gdata.ulongValue = GlobalData(control.globaldataSlot[i]);
     
-    Device* device = group->feedbackDevice;
-    switch(group->feedbackType) {
+    Device* device = control.feedbackDevice[i];
+    switch(control.feedbackType[i]) {
         case FeedbackType_IME:
             PresetIntegratedMotorEncoder(((Motor*) device)->port, (long) gdata.ulongValue);
             break;
@@ -569,7 +704,7 @@ void MotorGroup_restorePosition(MotorGroup* group) {
             break;
         default: break;
     }
-    group->speedCycle = 0;
+    control.speedCycle[i] = 0;
 }
 
 // closed loop control //
@@ -577,20 +712,21 @@ void MotorGroup_restorePosition(MotorGroup* group) {
 bool MotorGroup_isPIDEnabled(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->pidEnabled;
+    return control.pidEnabled[group->slot];
 }
 
 void MotorGroup_setPIDEnabled(MotorGroup* group, bool value) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
     ErrorIf(VexOS_getRunMode() == RunMode_Setup, VEXOS_NOTINITIALIZED);
-    if(value == group->pidEnabled) return;
+    unsigned short i = group->slot;
+    if(value == control.pidEnabled[i]) return;
 
     // if enabling, enable feedback if not active already //
-    if(value && !group->feedbackEnabled) {
+    if(value && !control.feedbackEnabled[i]) {
         MotorGroup_setFeedbackEnabled(group, true);
     }
 
-    group->pidEnabled = value;
+    control.pidEnabled[i] = value;
     // if turning off, make sure motor power is zero //
     if(!value) {
         MotorGroup_setPower(group, 0.0);
@@ -601,33 +737,34 @@ void MotorGroup_setPID(MotorGroup* group, float kP, float kI, float kD) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
     ErrorIf(kP < 0 || kI < 0 || kD < 0, VEXOS_ARGRANGE);
 
-    group->pid.kP = kP;
-    group->pid.kI = kI;
-    group->pid.kD = kD;
+    PIDState* pid = &control.pid[group->slot];
+    pid->kP = kP;
+    pid->kI = kI;
+    pid->kD = kD;
 }
 
 float MotorGroup_getP(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->pid.kP;
+    return control.pid[group->slot].kP;
 }
 
 float MotorGroup_getI(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->pid.kI;
+    return control.pid[group->slot].kI;
 }
 
 float MotorGroup_getD(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->pid.kD;
+    return control.pid[group->slot].kD;
 }
 
 float MotorGroup_getError(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->pid.error * group->outputScale;
+    return control.pid[group->slot].error * group->outputScale;
 }
 
 float MotorGroup_getTolerance(MotorGroup* group) {
@@ -646,18 +783,18 @@ void MotorGroup_setTolerance(MotorGroup* group, float value) {
 bool MotorGroup_onTarget(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
     
-    if(!group->pidEnabled) return true;
-    return (ABS(group->pid.error) < group->pidTolerance);
+    if(!control.pidEnabled[group->slot]) return true;
+    return (ABS(control.pid[group->slot].error) < group->pidTolerance);
 }
 
 float MotorGroup_getSetpoint(MotorGroup* group) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    return group->pid.command * group->outputScale;
+    return control.pid[group->slot].command * group->outputScale;
 }
 
 void MotorGroup_setSetpoint(MotorGroup* group, float value) {
     ErrorIf(group == NULL, VEXOS_ARGNULL);
 
-    group->pid.command = (value / group->outputScale);
+    control.pid[group->slot].command = (value / group->outputScale);
 }
@@ -23,6 +23,7 @@
 
 #include "Hardware.h"
 #include "Device.h"
+#include "InputLog.h"
 #include "Error.h"
 
 /********************************************************************
@@ -110,6 +111,8 @@ float PowerExpander_getBatteryVoltage(PowerExpander* expand) {
     ErrorMsgIf(expand->statusPort == 0, VEXOS_OPINVALID, 
                "Expander has no status port set: %s", expand->name);
 
-    float volts = ((GetAnalogInput(expand->statusPort) * 10.0f) / expand->expandType);
+    long  raw   = LogInput(InputChannel_Analog + expand->statusPort - 1,
+                           GetAnalogInput(expand->statusPort));
+    float volts = ((raw * 10.0f) / expand->expandType);
     return volts;
 }
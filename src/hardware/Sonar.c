@@ -23,6 +23,7 @@
 
 #include "Hardware.h"
 #include "Device.h"
+#include "InputLog.h"
 #include "Error.h"
 
 /********************************************************************
@@ -91,7 +92,8 @@ void Sonar_setEnabled(Sonar* sonar, bool value) {
 int Sonar_getDistanceInches(Sonar* sonar) {
     ErrorIf(sonar == NULL, VEXOS_ARGNULL);
 
-    return GetUltrasonic(sonar->inputPort, sonar->outputPort);
+    return LogInput(InputChannel_Sonar + sonar->inputPort - 1,
+                    GetUltrasonic(sonar->inputPort, sonar->outputPort));
 }
 
 float Sonar_getDistanceCentimeters(Sonar* sonar) {
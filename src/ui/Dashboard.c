@@ -23,6 +23,8 @@
 
 #include "UserInterface.h"
 #include "Window.h"
+#include "LoopStats.h"
+#include "Task.h"
 #include "Error.h"
 
 /********************************************************************
@@ -38,6 +40,7 @@ struct Dashboard {
 
 static List dashboards;
 static unsigned int dashNumber = 0;
+static Task*        periodicTask;
 
 static void setDashNumber(unsigned int n) {
     // refresh the newly set dashboard //
@@ -91,14 +94,7 @@ static void startCallback(EventType type, void* state) {
     Dashboard_refresh();
 }
 
-static void periodicCallback(EventType type, void* state) {
-    static unsigned long nextTime = 0;
-    unsigned long time = GetMsClock();
-    
-    // make sure we display the dashboard //
-    if(dashNumber == 0 || time < nextTime) return;
-
-    Dashboard* dash = List_getDataByIndex(&dashboards, dashNumber - 1);
+static void advanceWindow(Dashboard* dash) {
     if(!dash->windowNode) {
         dash->windowNode = dash->windowList.firstNode;
         // at start of list, clear GD //
@@ -114,11 +110,21 @@ static void periodicCallback(EventType type, void* state) {
             dash->refresh = false;
         }
     }
-    if(!dash->windowNode) return;
-    Window_draw((Window*) dash->windowNode->data, dash->refresh);
+}
 
-    // set next display time //
-    nextTime = time + DASH_PERIOD;
+static void drawTask(Task* task, void* state) {
+    // make sure we display the dashboard //
+    if(dashNumber == 0) return;
+    LoopStats_mark(LoopPhase_Events);
+
+    Dashboard* dash = List_getDataByIndex(&dashboards, dashNumber - 1);
+    advanceWindow(dash);
+    // the end of the list wraps without waiting another period //
+    if(!dash->windowNode) advanceWindow(dash);
+    if(dash->windowNode) {
+        Window_draw((Window*) dash->windowNode->data, dash->refresh);
+    }
+    LoopStats_mark(LoopPhase_UI);
 }
 
 static void errorCallback(EventType type, void* state) {
@@ -144,10 +150,8 @@ Dashboard* Dashboard_new(String name) {
         VexOS_addEventHandler(EventType_Initialize,      &startCallback, NULL);
         VexOS_addEventHandler(EventType_AutonomousStart, &startCallback, NULL);
         VexOS_addEventHandler(EventType_OperatorStart,   &startCallback, NULL);
-        // set the periodic update event //
-        VexOS_addEventHandler(EventType_DisabledPeriodic,   &periodicCallback, NULL);
-        VexOS_addEventHandler(EventType_AutonomousPeriodic, &periodicCallback, NULL);
-        VexOS_addEventHandler(EventType_OperatorPeriodic,   &periodicCallback, NULL);
+        // update in the background //
+        periodicTask = Task_new("Dashboard", DASH_PERIOD, TASK_PRIORITY_DASHBOARD, &drawTask, NULL);
         // set the system error trap //
         VexOS_addEventHandler(EventType_SystemError, &errorCallback, NULL);
     }
@@ -166,9 +170,7 @@ Dashboard* Dashboard_delete(Dashboard* dash) {
         VexOS_removeEventHandler(EventType_Initialize,         &startCallback);
         VexOS_removeEventHandler(EventType_AutonomousStart,    &startCallback);
         VexOS_removeEventHandler(EventType_OperatorStart,      &startCallback);
-        VexOS_removeEventHandler(EventType_DisabledPeriodic,   &periodicCallback);
-        VexOS_removeEventHandler(EventType_AutonomousPeriodic, &periodicCallback);
-        VexOS_removeEventHandler(EventType_OperatorPeriodic,   &periodicCallback);
+        periodicTask = Task_delete(periodicTask);
         VexOS_removeEventHandler(EventType_SystemError,        &errorCallback);
     }
     return NULL;
@@ -24,6 +24,8 @@
 #include "LCDScreen.h"
 #include "Hardware.h"
 #include "Device.h"
+#include "LoopStats.h"
+#include "Task.h"
 #include "Error.h"
 
 /********************************************************************
@@ -109,24 +111,23 @@ static void runLCD(LCD* lcd) {
     }
 }
 
-static void eventCallback(EventType type, void* state) {
-    static unsigned long nextLCDTime = 0;
-    unsigned long time = GetMsClock();
-    
-    // normal display //
-    if(time > nextLCDTime || type == EventType_SystemError) {
-        ListNode* node = lcds.firstNode;
-        while(node != NULL) {
-            LCD* lcd = node->data;
-            if(type != EventType_SystemError) {
-                runLCD(lcd);
-            } else {
-                LCD_setText(lcd, 1, LCDTextOptions_Centered, "ERROR");
-                LCD_setText(lcd, 2, LCDTextOptions_None, Error_getMessage());
-            }
-            node = node->next;
-        }
-        nextLCDTime = time + LCD_PERIOD;
+static void drawTask(Task* task, void* state) {
+    LoopStats_mark(LoopPhase_Events);
+    ListNode* node = lcds.firstNode;
+    while(node != NULL) {
+        runLCD((LCD*) node->data);
+        node = node->next;
+    }
+    LoopStats_mark(LoopPhase_UI);
+}
+
+static void errorCallback(EventType type, void* state) {
+    ListNode* node = lcds.firstNode;
+    while(node != NULL) {
+        LCD* lcd = node->data;
+        LCD_setText(lcd, 1, LCDTextOptions_Centered, "ERROR");
+        LCD_setText(lcd, 2, LCDTextOptions_None, Error_getMessage());
+        node = node->next;
     }
 }
 
@@ -154,10 +155,8 @@ LCD* LCD_new(String name, UARTPort port) {
 
     // check for first LCD and install handler //
     if(lcds.nodeCount == 1) {
-        VexOS_addEventHandler(EventType_DisabledPeriodic,   &eventCallback, NULL);
-        VexOS_addEventHandler(EventType_AutonomousPeriodic, &eventCallback, NULL);
-        VexOS_addEventHandler(EventType_OperatorPeriodic,   &eventCallback, NULL);
-        VexOS_addEventHandler(EventType_SystemError,        &eventCallback, NULL);
+        Task_new("LCD", LCD_PERIOD, TASK_PRIORITY_LCD, &drawTask, NULL);
+        VexOS_addEventHandler(EventType_SystemError, &errorCallback, NULL);
     }
     return ret;
 }
@@ -22,6 +22,7 @@
 #include "API.h"
 
 #include "UserInterface.h"
+#include "Arena.h"
 #include "Error.h"
 
 /********************************************************************
@@ -53,6 +54,10 @@ static void updateWindow(Window* win, bool full) {
     }
     // run time //
     PrintTextToGD(top + 2, left, Color_Black, "Run:  %d s\n", VexOS_getRunTime());
+    // allocations made after the arena was sealed //
+    unsigned long heapAllocs = Arena_getHeapAllocs();
+    PrintTextToGD(top + 3, left, (heapAllocs > 0)? Color_DarkRed: Color_Black,
+                  "Heap: %lu\n", heapAllocs);
 }
 
 static void drawLCDScreen(LCDScreen* screen, LCDButtonType pressed) {
@@ -65,7 +70,10 @@ static void drawLCDScreen(LCDScreen* screen, LCDButtonType pressed) {
     }
     LCD* lcd = LCDScreen_getLCD(screen);
     LCD_setText(lcd, 1, LCDTextOptions_None, "%-8s%6d s", modeStr, VexOS_getRunTime());
-    LCD_setText(lcd, 2, LCDTextOptions_None, "<VexOS>%6.0f Hz", VexOS_getLoopFrequency());
+    LoopStats stats;
+    VexOS_getLoopStats(&stats);
+    LCD_setText(lcd, 2, LCDTextOptions_None, "%4.0fHz Max%5lu", VexOS_getLoopFrequency(),
+                stats.maxMicros);
 }
 
 
@@ -77,7 +85,7 @@ Window* Status_getWindow() {
     static Window* window = NULL;
     if(window) return window;
     window = Window_new("Robot Status", &updateWindow);
-    Window_setSize(window, 16, 3);
+    Window_setSize(window, 16, 4);
     return window;
 }
 